@@ -0,0 +1,49 @@
+;
+; conn-match.scm -- Connector matching with lg-conn-linkable?
+;
+; Matches every connector against every other, in a set of common
+; English connector names, and then in a set of names too long to be
+; packed, which are matched by name. It prints the time per match,
+; and, as a baseline, the time per call of a Scheme primitive that
+; does almost nothing; the difference is the cost of the match itself.
+;
+; -----------------------------------------------------------------
+
+(use-modules (opencog) (opencog lg))
+
+(define nrounds 200)
+
+(define short-names
+	'("Ss" "Sp" "S*s" "hSs" "dSs" "SIs" "SFsi" "MVp" "MVa" "Jp" "Js" "Wd"
+	"Xp" "Xc" "Os" "Op" "O*t" "Ds**c" "Dmc" "D*u" "EBm" "AN" "A" "hI"
+	"dI*d" "PP" "Pa" "Pg*b" "TO" "Mp" "Mv" "R" "RS" "B*m" "CO" "Ce"))
+
+(define long-names
+	(map (lambda (n) (string-append "ABCDEFGHIJKLMNOP" n)) short-names))
+
+(define (connectors names)
+	(append
+		(map (lambda (n) (LgConnector (LgConnNode n) (LgConnDirNode "+"))) names)
+		(map (lambda (n) (LgConnector (LgConnNode n) (LgConnDirNode "-"))) names)))
+
+(define (time-pairs label conns fn)
+	(define start (get-internal-real-time))
+	(define nmatch 0)
+	(do ((i 0 (+ i 1))) ((= i nrounds))
+		(for-each
+			(lambda (a)
+				(for-each (lambda (b) (if (fn a b) (set! nmatch (+ nmatch 1))))
+					conns))
+			conns))
+	(format #t "~12a ~8,3f usec/match, ~d matched\n" label
+		(/ (* 1.0e6 (- (get-internal-real-time) start))
+			(* nrounds (length conns) (length conns)
+				internal-time-units-per-second))
+		(/ nmatch nrounds)))
+
+(define short-conns (connectors short-names))
+(define long-conns (connectors long-names))
+
+(time-pairs "Baseline" short-conns (lambda (a b) (cog-atom? a)))
+(time-pairs "Short names" short-conns lg-conn-linkable?)
+(time-pairs "Long names" long-conns lg-conn-linkable?)
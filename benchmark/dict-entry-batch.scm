@@ -0,0 +1,67 @@
+;
+; dict-entry-batch.scm -- LgDictEntry over a word list, one at a time
+; and as a batch.
+;
+; Looks up every word of a word list, first by executing one
+; LgDictEntry per word, and then with a single LgDictEntry holding a
+; ListLink of all of them, and prints the time taken by each. The
+; entry cache is turned off, so that both go all the way to Link
+; Grammar. The batch uses all CPUs.
+;
+; The word list has one word per line; by default, the system
+; dictionary. Give another on the command line:
+;    guile -s dict-entry-batch.scm my-lexicon.txt
+;
+; -----------------------------------------------------------------
+
+(use-modules (ice-9 rdelim) (srfi srfi-1))
+(use-modules (opencog) (opencog exec) (opencog lg))
+
+(define dict (LgDictNode "en"))
+(define max-words 20000)
+
+(define word-file
+	(if (< 1 (length (command-line)))
+		(cadr (command-line))
+		"/usr/share/dict/words"))
+
+(define words
+	(call-with-input-file word-file
+		(lambda (port)
+			(let loop ((line (read-line port)) (n 0) (acc '()))
+				(if (or (eof-object? line) (<= max-words n))
+					(reverse acc)
+					(loop (read-line port) (+ n 1)
+						(if (string-null? line) acc (cons line acc))))))))
+
+(lg-dict-cache-config dict 0 0)
+
+; Load the dictionary before timing anything.
+(cog-execute! (LgDictEntry (Word "the") dict))
+
+(define (elapsed start)
+	(exact->inexact
+		(/ (- (get-internal-real-time) start) internal-time-units-per-second)))
+
+(define (count-djs results)
+	(fold (lambda (r n) (+ n (length (cog-value->list r)))) 0 results))
+
+(format #t "~d words from ~a\n" (length words) word-file)
+
+(define start (get-internal-real-time))
+(define one-by-one
+	(map (lambda (w) (cog-execute! (LgDictEntry (Word w) dict))) words))
+(format #t "One at a time: ~8,3f secs, ~d disjuncts\n"
+	(elapsed start) (count-djs one-by-one))
+
+(set! start (get-internal-real-time))
+(define batch
+	(cog-execute! (LgDictEntry (List (map Word words)) dict)))
+(format #t "Batch:         ~8,3f secs, ~d disjuncts\n"
+	(elapsed start) (count-djs (cog-value->list batch)))
+
+(set! start (get-internal-real-time))
+(define have
+	(cog-execute! (LgHaveDictEntry (List (map Word words)) dict)))
+(format #t "Have, batch:   ~8,3f secs, ~d known\n"
+	(elapsed start) (length (filter identity (cog-value->list have))))
@@ -0,0 +1,54 @@
+;
+; dict-entry-heavy.scm -- LgDictEntry lookup cost, for heavy words.
+;
+; Some words in the English dictionary have very large expressions;
+; expanding them to disjunctive normal form produces thousands of
+; disjuncts. This looks up each of them repeatedly, with the entry
+; cache turned off, and prints the number of disjuncts, and the time
+; per lookup. It also prints the peak resident memory of the process.
+;
+; To count the allocations made during the lookups, run it under an
+; allocation profiler, e.g.
+;    heaptrack guile -s dict-entry-heavy.scm
+;
+; -----------------------------------------------------------------
+
+(use-modules (ice-9 rdelim) (ice-9 regex))
+(use-modules (opencog) (opencog exec) (opencog lg))
+
+(define dict (LgDictNode "en"))
+(define nrep 20)
+
+(define heavy-words
+	'("and" "or" "but" "that" "which" "is" "was" "be" "have" "to" "as" ","))
+
+; Every lookup goes all the way to Link Grammar.
+(lg-dict-cache-config dict 0 0)
+
+; Peak resident memory, in kB, from /proc.
+(define (peak-rss)
+	(call-with-input-file "/proc/self/status"
+		(lambda (port)
+			(let loop ((line (read-line port)))
+				(cond
+					((eof-object? line) 0)
+					((string-prefix? "VmHWM:" line)
+						(string->number
+							(match:substring (string-match "[0-9]+" line))))
+					(else (loop (read-line port))))))))
+
+(define (time-word WORD)
+	(define entry (LgDictEntry (Word WORD) dict))
+	(define ndj (length (cog-value->list (cog-execute! entry))))
+	(define start (get-internal-real-time))
+	(let loop ((i 0))
+		(when (< i nrep) (cog-execute! entry) (loop (+ i 1))))
+	(format #t "~12a ~6d disjuncts  ~8,3f ms/lookup\n" WORD ndj
+		(/ (* 1000.0 (- (get-internal-real-time) start))
+			(* nrep internal-time-units-per-second))))
+
+; Load the dictionary before timing anything.
+(cog-execute! (LgDictEntry (Word "the") dict))
+
+(for-each time-word heavy-words)
+(format #t "Peak RSS: ~d kB\n" (peak-rss))
@@ -0,0 +1,64 @@
+;
+; dict-reload.scm -- Reload latency, and parse jitter during a reload.
+;
+; One thread parses the same sentence over and over, timing each
+; parse. Half-way through, the dictionary is reloaded in the
+; background. Prints how long the reload took, and the parse times
+; before, during and after it. Parses should not stall while the new
+; dictionary is being opened; at most, they slow down somewhat, as
+; the reload competes with them for CPU and memory bandwidth.
+;
+; -----------------------------------------------------------------
+
+(use-modules (ice-9 threads))
+(use-modules (opencog) (opencog exec) (opencog lg))
+
+(define dict (LgDictNode "en"))
+(define parser
+	(LgParseBonds (Phrase "The quick brown fox jumped over the lazy dog.")
+		dict (Number 4)))
+
+; Each entry is (phase . milliseconds)
+(define phase 'before)
+(define done #f)
+(define timings '())
+
+(define (parse-loop)
+	(if (not done)
+		(let ((start (get-internal-real-time))
+				(ph phase))
+			(cog-execute! parser)
+			(set! timings
+				(cons (cons ph (/ (* 1000.0 (- (get-internal-real-time) start))
+					internal-time-units-per-second))
+				timings))
+			(parse-loop))))
+
+(define (reloading?)
+	(< 0.5 (list-ref (cog-value->list (lg-dict-reload-stats dict)) 2)))
+
+; Load the dictionary, and warm it up.
+(cog-execute! parser)
+(define parse-thread (call-with-new-thread parse-loop))
+
+(sleep 3)
+(set! phase 'during)
+(lg-dict-reload dict)
+(let wait () (when (reloading?) (usleep 10000) (wait)))
+(set! phase 'after)
+(sleep 3)
+(set! done #t)
+(join-thread parse-thread)
+
+(define (report PH)
+	(define ms (sort (map cdr (filter (lambda (t) (eq? PH (car t))) timings)) <))
+	(define n (length ms))
+	(if (< 0 n)
+		(format #t "~6a ~5d parses  median ~,2f ms  p99 ~,2f ms  max ~,2f ms\n"
+			PH n (list-ref ms (quotient n 2))
+			(list-ref ms (min (- n 1) (inexact->exact (floor (* 0.99 n)))))
+			(list-ref ms (- n 1)))))
+
+(format #t "Reload took ~,2f seconds\n"
+	(list-ref (cog-value->list (lg-dict-reload-stats dict)) 1))
+(for-each report '(before during after))
@@ -0,0 +1,59 @@
+;
+; parse-compact.scm -- LgParseCompact vs. LgParseBonds.
+;
+; LgParseCompact returns parses as strings and numbers, without any
+; Atoms; LgParseBonds creates WordNodes, BondNodes, ListLinks and
+; EdgeLinks. This parses the same set of distinct sentences with each,
+; and prints the time and the memory growth per sentence. Memory is
+; the growth of the resident set size, and so is approximate; run
+; each of the two in a fresh guile process for cleaner numbers, e.g.
+;     guile -s parse-compact.scm bonds
+;     guile -s parse-compact.scm compact
+;
+; -----------------------------------------------------------------
+
+(use-modules (opencog) (opencog exec) (opencog lg))
+(use-modules (ice-9 rdelim))
+
+(define dict (LgDictNode "any"))
+(define nlkgs 20)
+(define nsent 2000)
+
+; Distinct sentences, so that no Atoms are shared between them.
+(define sentences
+	(map
+		(lambda (i)
+			(format #f "the w~a saw a v~a near the x~a of y~a" i i i i))
+		(iota nsent)))
+
+; Resident set size, in bytes.
+(define (rss)
+	(define statm (call-with-input-file "/proc/self/statm" read-line))
+	(* 4096 (string->number (cadr (string-split statm #\space)))))
+
+(define (run NAME PARSER)
+	(define start-mem (rss))
+	(define start (get-internal-real-time))
+	; Keep the results, so that their memory is counted.
+	(define results
+		(map
+			(lambda (s) (cog-execute! (PARSER (Phrase s) dict (Number nlkgs))))
+			sentences))
+	(define secs
+		(/ (exact->inexact (- (get-internal-real-time) start))
+			internal-time-units-per-second))
+	(format #t "~a: ~,1f microseconds, ~,0f bytes per sentence (~a results)\n"
+		NAME (/ (* 1.0e6 secs) nsent)
+		(/ (exact->inexact (- (rss) start-mem)) nsent)
+		(length results)))
+
+; Warm up: the first parse loads the dictionary.
+(cog-execute! (LgParseBonds (Phrase "this is a test.") dict (Number 1)))
+
+(define which
+	(if (< 1 (length (command-line))) (cadr (command-line)) "both"))
+
+(when (member which '("bonds" "both"))
+	(run "LgParseBonds" LgParseBonds))
+(when (member which '("compact" "both"))
+	(run "LgParseCompact" LgParseCompact))
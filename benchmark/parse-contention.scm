@@ -0,0 +1,46 @@
+;
+; parse-contention.scm -- Batch parsing throughput vs. thread count.
+;
+; Parses a batch of sentences with 1, 4, 16 and 64 threads. All of
+; the threads add their Atoms to the same AtomSpace; if the throughput
+; stops rising well before the core count, that is where to look.
+;
+; -----------------------------------------------------------------
+
+(use-modules (opencog) (opencog exec) (opencog lg))
+
+(define dict (LgDictNode "any"))
+(define nlkgs 200)
+(define nsent 256)
+
+(define sentences
+	(map
+		(lambda (i)
+			(format #f "the w~a saw a v~a near the x~a of y~a" i i i i))
+		(iota nsent)))
+
+(cog-set-value! (Anchor "bench") (Predicate "sentences")
+	(apply StringValue sentences))
+
+(define parser
+	(LgParseLink
+		(ValueOf (Anchor "bench") (Predicate "sentences"))
+		dict (Number nlkgs)))
+
+; Parse the batch with NTHR threads. Return sentences per second.
+(define (throughput NTHR)
+	(cog-set-value! parser (Predicate "*-lg-parse-threads-*")
+		(FloatValue NTHR))
+	(let ((start (get-internal-real-time)))
+		(cog-execute! parser)
+		(/ (* nsent internal-time-units-per-second)
+			(exact->inexact (- (get-internal-real-time) start)))))
+
+; Warm up: load the dictionary, and create the Atoms once, so that
+; every run below sees the same AtomSpace contents.
+(throughput 1)
+
+(for-each
+	(lambda (n)
+		(format #t "~2d threads: ~,1f sentences/sec\n" n (throughput n)))
+	'(1 4 16 64))
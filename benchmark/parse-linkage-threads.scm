@@ -0,0 +1,38 @@
+;
+; parse-linkage-threads.scm -- Scaling of linkage conversion with threads.
+;
+; With the "any" dictionary, a sentence has a huge number of linkages,
+; and converting thousands of them into Atoms takes longer than the
+; parse itself. The conversion can be spread over several threads, set
+; with *-lg-linkage-threads-*. This parses one sentence, asking for many
+; linkages, with 1 to N threads.
+;
+; -----------------------------------------------------------------
+
+(use-modules (opencog) (opencog exec) (opencog lg))
+
+(define sentence
+	"this is a rather long sentence, with lots of words, for the random parser")
+
+(define dict (LgDictNode "any"))
+(define nlkgs 3000)
+(define threads-key (Predicate "*-lg-linkage-threads-*"))
+
+; Parse with NTHR threads, ITERS times. Return seconds per parse.
+(define (time-parse NTHR ITERS)
+	(define parser (LgParseLink (Phrase sentence) dict (Number nlkgs)))
+	(cog-set-value! parser threads-key (FloatValue NTHR))
+	(let ((start (get-internal-real-time)))
+		(for-each (lambda (i) (cog-execute! parser)) (iota ITERS))
+		(/ (exact->inexact (- (get-internal-real-time) start))
+			(* ITERS internal-time-units-per-second))))
+
+; Warm up: the first parse loads the dictionary.
+(time-parse 1 1)
+
+(define ncpus (current-processor-count))
+(for-each
+	(lambda (n)
+		(format #t "~2d threads: ~,1f milliseconds per parse\n"
+			n (* 1.0e3 (time-parse n 5))))
+	(filter (lambda (n) (<= n ncpus)) '(1 2 4 8 16 32 64)))
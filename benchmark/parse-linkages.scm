@@ -0,0 +1,36 @@
+;
+; parse-linkages.scm -- Cost of building Atoms for many linkages.
+;
+; For a long sentence, with many linkages requested, most of the time
+; of an LgParseLink goes into converting each linkage into Atoms. This
+; measures the average time per linkage, for each of the parse links.
+;
+; -----------------------------------------------------------------
+
+(use-modules (opencog) (opencog exec) (opencog lg))
+
+(define sentence
+	"The quick brown fox that I saw yesterday jumped over the lazy dog in the garden.")
+
+(define dict (LgDictNode "en"))
+(define nlkgs 100)
+
+; Run PARSER ITERS times. Return seconds per linkage.
+(define (time-linkages PARSER ITERS)
+	(define start (get-internal-real-time))
+	(for-each
+		(lambda (i)
+			(cog-execute! (PARSER (Phrase sentence) dict (Number nlkgs))))
+		(iota ITERS))
+	(/ (exact->inexact (- (get-internal-real-time) start))
+		(* ITERS nlkgs internal-time-units-per-second)))
+
+; Warm up: the first parse loads the dictionary.
+(time-linkages LgParseBonds 1)
+
+(for-each
+	(lambda (name parser)
+		(format #t "~a: ~,1f microseconds per linkage\n"
+			name (* 1.0e6 (time-linkages parser 20))))
+	(list "LgParseLink" "LgParseBonds" "LgParseSections" "LgParseDisjuncts")
+	(list LgParseLink LgParseBonds LgParseSections LgParseDisjuncts))
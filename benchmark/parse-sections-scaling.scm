@@ -0,0 +1,44 @@
+;
+; parse-sections-scaling.scm -- Section-building cost vs. sentence length.
+;
+; The Sections of a linkage are built from its links, word by word.
+; This should scale linearly with the number of links, and thus with
+; the sentence length. It parses sentences of 10 to 100 words, and
+; prints the time per linkage for LgParseSections, next to that for
+; LgParseBonds; the difference is the cost of the Sections.
+;
+; -----------------------------------------------------------------
+
+(use-modules (opencog) (opencog exec) (opencog lg))
+
+(define dict (LgDictNode "en"))
+(define nlkgs 20)
+
+; A sentence of about N words: short clauses, joined by "and".
+(define (make-sentence N)
+	(define clause "the cat saw the dog")
+	(define nclauses (max 1 (quotient (+ N 1) 6)))
+	(string-append
+		(string-join (make-list nclauses clause) " and ") "."))
+
+; Run PARSER on SENT, ITERS times. Return seconds per linkage.
+(define (time-linkages PARSER SENT ITERS)
+	(define start (get-internal-real-time))
+	(for-each
+		(lambda (i)
+			(cog-execute! (PARSER (Phrase SENT) dict (Number nlkgs))))
+		(iota ITERS))
+	(/ (exact->inexact (- (get-internal-real-time) start))
+		(* ITERS nlkgs internal-time-units-per-second)))
+
+; Warm up: the first parse loads the dictionary.
+(time-linkages LgParseBonds "this is a test." 1)
+
+(for-each
+	(lambda (n)
+		(define sent (make-sentence n))
+		(format #t "~3d words: sections ~,1f  bonds ~,1f microseconds per linkage\n"
+			n
+			(* 1.0e6 (time-linkages LgParseSections sent 5))
+			(* 1.0e6 (time-linkages LgParseBonds sent 5))))
+	'(10 20 40 60 80 100))
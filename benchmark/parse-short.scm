@@ -0,0 +1,36 @@
+;
+; parse-short.scm -- Per-call overhead of parsing short sentences.
+;
+; For short sentences, the parse itself is fast, and the fixed costs
+; of each LgParseLink execution (parse option setup, teardown, Atom
+; creation) are a large share of the total. This measures the average
+; time per call, over many calls.
+;
+; -----------------------------------------------------------------
+
+(use-modules (opencog) (opencog exec) (opencog lg))
+
+(define sentences
+	(list "this is a test." "I saw the dog." "she runs." "go away!"
+		"it is red." "we like cats." "he ate." "the sun shines."))
+
+(define dict (LgDictNode "en"))
+
+; Parse every sentence once, ITERS times over. Return seconds/parse.
+(define (time-parses ITERS)
+	(define start (get-internal-real-time))
+	(for-each
+		(lambda (i)
+			(for-each
+				(lambda (s)
+					(cog-execute! (LgParseBonds (Phrase s) dict (Number 1))))
+				sentences))
+		(iota ITERS))
+	(/ (exact->inexact (- (get-internal-real-time) start))
+		(* ITERS (length sentences) internal-time-units-per-second)))
+
+; Warm up: the first parse loads the dictionary.
+(time-parses 1)
+
+(format #t "Short sentences: ~,1f microseconds per parse\n"
+	(* 1.0e6 (time-parses 500)))
@@ -0,0 +1,161 @@
+/*
+ * LGConnNode.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+
+#include <opencog/atoms/atom_types/NameServer.h>
+
+#include "LGConnNode.h"
+
+using namespace opencog;
+
+static inline bool is_upper(char c) { return 'A' <= c and c <= 'Z'; }
+static inline bool is_lower(char c) { return 'a' <= c and c <= 'z'; }
+
+LgConnDesc::LgConnDesc(const std::string& name)
+{
+	chars[0] = chars[1] = 0;
+	upper[0] = upper[1] = 0;
+	wild[0] = wild[1] = 0;
+
+	size_t start = 0;
+	head = 0;
+	if (0 < name.size() and is_lower(name[0]))
+	{
+		head = name[0];
+		start = 1;
+	}
+
+	size_t n = name.size() - start;
+	if (MAX_LEN < n)
+	{
+		len = LONG_NAME;
+		return;
+	}
+	len = n;
+
+	for (size_t k = 0; k < n; k++)
+	{
+		char c = name[start + k];
+		unsigned shift = 8 * (k % 8);
+		chars[k / 8] |= ((uint64_t) (unsigned char) c) << shift;
+		if (is_upper(c)) upper[k / 8] |= 0xffULL << shift;
+		if ('*' == c) wild[k / 8] |= 0xffULL << shift;
+	}
+}
+
+/// 0x80 in each byte of x that is not zero, and 0 elsewhere.
+static inline uint64_t nonzero_bytes(uint64_t x)
+{
+	const uint64_t lo7 = 0x7f7f7f7f7f7f7f7fULL;
+	return (((x & lo7) + lo7) | x) & ~lo7;
+}
+
+/// All ones in the bytes below n, counting from byte `from`.
+static inline uint64_t len_mask(size_t n, size_t from)
+{
+	if (n <= from) return 0;
+	if (from + 8 <= n) return ~0ULL;
+	return (1ULL << (8 * (n - from))) - 1;
+}
+
+/// Same rules as lg_conn_name_match(), below, a word at a time: the
+/// bytes must be equal where either one is uppercase, and elsewhere,
+/// equal unless one of them is a wildcard. Only as many bytes as the
+/// shorter name has are compared.
+bool opencog::lg_conn_desc_match(const LgConnDesc& a, const LgConnDesc& b)
+{
+	if (a.head and b.head and a.head == b.head)
+		return false;
+
+	size_t n = std::min(a.len, b.len);
+	for (size_t w = 0; w < 2; w++)
+	{
+		uint64_t mask = len_mask(n, 8 * w);
+		if (0 == mask) break;
+
+		uint64_t differ = (nonzero_bytes(a.chars[w] ^ b.chars[w]) >> 7) * 0xff;
+		uint64_t wildok = (a.wild[w] & ~b.upper[w]) | (b.wild[w] & ~a.upper[w]);
+		if (differ & ~wildok & mask) return false;
+	}
+	return true;
+}
+
+/// Walk the two names side by side. The first character is the head
+/// or tail marker, if it is lowercase; two of the same kind do not
+/// match. After that, uppercase letters must be equal; the rest must
+/// be equal, unless one of them is "*". Only as many characters as
+/// the shorter name has are compared, so that "S" matches "SX".
+bool opencog::lg_conn_name_match(const std::string& type1,
+                                 const std::string& type2)
+{
+	size_t i1 = 0;
+	size_t i2 = 0;
+
+	// check header
+	if (0 < type1.size() and is_lower(type1[i1]))
+		i1++;
+	if (0 < type2.size() and is_lower(type2[i2]))
+		i2++;
+
+	if (i1 > 0 and i2 > 0 and type1[0] == type2[0])
+		return false;
+
+	while (i1 < type1.length() and i2 < type2.length())
+	{
+		if (is_upper(type1[i1]) or is_upper(type2[i2]))
+		{
+			if (type1[i1] != type2[i2])
+				return false;
+		}
+		else if (type1[i1] != '*' and type2[i2] != '*' and
+		         type1[i1] != type2[i2])
+			return false;
+
+		i1++;
+		i2++;
+	}
+
+	return true;
+}
+
+// ------------------------------------------------------
+
+LgConnNode::LgConnNode(const std::string&& name)
+	: Node(LG_CONN_NODE, std::move(name)), _desc(get_name())
+{
+}
+
+Handle LgConnNode::factory(const Handle& base)
+{
+	if (LgConnNodeCast(base)) return base;
+	std::string cname = base->get_name();
+	Handle h(createLgConnNode(std::move(cname)));
+	return h;
+}
+
+/* This runs when the shared lib is loaded. */
+static __attribute__ ((constructor)) void init(void)
+{
+	classserver().addFactory(LG_CONN_NODE, &LgConnNode::factory);
+}
+
+/* ===================== END OF FILE ===================== */
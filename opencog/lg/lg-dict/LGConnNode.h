@@ -0,0 +1,98 @@
+/*
+ * LGConnNode.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LG_CONN_NODE_H
+#define _OPENCOG_LG_CONN_NODE_H
+
+#include <cstdint>
+#include <string>
+
+#include <opencog/atoms/base/Node.h>
+#include <opencog/lg/types/atom_types.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// A connector name, e.g. "hSs*b", taken apart for fast matching.
+///
+/// The optional lowercase head/tail marker is held apart from the
+/// rest. The rest is packed one character per byte, along with masks
+/// marking the bytes that are uppercase and the bytes that are "*"
+/// wildcards. Two of them can then be matched a word at a time, with
+/// a handful of integer operations, and without looking at the
+/// strings. Names longer than MAX_LEN (after the head/tail marker)
+/// do not fit; they are marked as long, and must be matched by name.
+struct LgConnDesc
+{
+	static const size_t MAX_LEN = 16;
+	static const uint8_t LONG_NAME = 0xff;
+
+	uint64_t chars[2];
+	uint64_t upper[2];
+	uint64_t wild[2];
+	uint8_t len;
+	char head;
+
+	LgConnDesc(void) {}
+	LgConnDesc(const std::string&);
+
+	bool is_long(void) const { return LONG_NAME == len; }
+};
+
+// True if the two connector types match. Neither may be long.
+bool lg_conn_desc_match(const LgConnDesc&, const LgConnDesc&);
+
+// Same as above, working on the names. For the long ones.
+bool lg_conn_name_match(const std::string&, const std::string&);
+
+/// An LgConnNode that knows its LgConnDesc. It is worked out once,
+/// when the Node is created, rather than every time that the
+/// connector is matched.
+class LgConnNode : public Node
+{
+protected:
+	LgConnDesc _desc;
+
+public:
+	LgConnNode(const std::string&&);
+	LgConnNode(const LgConnNode&) = delete;
+	LgConnNode& operator=(const LgConnNode&) = delete;
+
+	const LgConnDesc& get_desc(void) const { return _desc; }
+
+	static Handle factory(const Handle&);
+};
+
+typedef std::shared_ptr<LgConnNode> LgConnNodePtr;
+static inline LgConnNodePtr LgConnNodeCast(const Handle& h)
+	{ return std::dynamic_pointer_cast<LgConnNode>(h); }
+static inline LgConnNodePtr LgConnNodeCast(AtomPtr a)
+	{ return std::dynamic_pointer_cast<LgConnNode>(a); }
+
+#define createLgConnNode std::make_shared<LgConnNode>
+
+/** @}*/
+}
+
+#endif // _OPENCOG_LG_CONN_NODE_H
@@ -21,15 +21,67 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <unordered_map>
+
 #include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/value/BoolValue.h>
 #include <opencog/atoms/value/LinkValue.h>
 #include <opencog/atomspace/AtomSpace.h>
 #include "LGDictNode.h"
 #include "LGDictEntry.h"
 #include "LGDictReader.h"
+#include "LGParallelFor.h"
 
 using namespace opencog;
 
+/// The first argument is either a word, or a list of them: a ListLink
+/// of WordNodes, or something that executes to a ListLink or to a
+/// LinkValue of WordNodes.
+static bool valid_words(const Handle& h)
+{
+	Type pht = h->get_type();
+	return WORD_NODE == pht or VARIABLE_NODE == pht or GLOB_NODE == pht
+		or LIST_LINK == pht or h->is_executable();
+}
+
+/// Unpack the words to look up. Sets `batch` if a list was given;
+/// else there is only the one word.
+static HandleSeq get_words(const Handle& h, AtomSpace* as, bool silent,
+                           bool& batch, const char* who)
+{
+	ValuePtr vp(h);
+	if (h->is_executable())
+		vp = h->execute(as, silent);
+
+	HandleSeq words;
+	batch = true;
+	if (vp->is_type(LINK_VALUE))
+	{
+		for (const ValuePtr& v : LinkValueCast(vp)->value())
+		{
+			if (not v->is_atom()) words.push_back(Handle::UNDEFINED);
+			else words.push_back(HandleCast(v));
+		}
+	}
+	else if (vp->is_type(LIST_LINK))
+		words = HandleCast(vp)->getOutgoingSet();
+	else
+	{
+		batch = false;
+		words.push_back(HandleCast(vp));
+	}
+
+	for (const Handle& w : words)
+	{
+		if (w and WORD_NODE == w->get_type()) continue;
+		if (silent) throw SilentException();
+		throw InvalidParamException(TRACE_INFO,
+			"%s: Expecting WordNode, got %s", who,
+			w ? w->to_string().c_str() : vp->to_string().c_str());
+	}
+	return words;
+}
+
 /// The expected format of an LgDictEntry is:
 ///
 ///     LgDictEntry
@@ -40,6 +92,11 @@ using namespace opencog;
 /// dictionary, and the dictionary entry will be placed into the
 /// atomspace.
 ///
+/// In place of the WordNode, a ListLink of WordNodes (or something
+/// that executes to a list of them) may be given. The words are then
+/// looked up concurrently, and a LinkValue is returned, holding one
+/// LinkValue of disjuncts per word, in the order of the words.
+///
 /// The LgDictEntry is a kind of FunctionLink, and can thus be used in
 /// any expression that FunctionLinks can be used with.
 ///
@@ -52,8 +109,7 @@ void LGDictEntry::init()
 		throw InvalidParamException(TRACE_INFO,
 			"LgDictEntry: Expecting two arguments, got %lu", osz);
 
-	Type pht = oset[0]->get_type();
-	if (WORD_NODE != pht and VARIABLE_NODE != pht and GLOB_NODE != pht)
+	if (not valid_words(oset[0]))
 		throw InvalidParamException(TRACE_INFO,
 			"LgDictEntry: Expecting WordNode, got %s",
 			oset[0]->to_string().c_str());
@@ -80,36 +136,83 @@ LGDictEntry::LGDictEntry(const HandleSeq&& oset, Type t)
 
 // =================================================================
 
-ValuePtr LGDictEntry::execute(AtomSpace* as, bool silent)
+/// Look up one word. Words that were looked up before come out of
+/// the cache.
+static HandleSeq lookup(const LgDictNodePtr& ldn,
+                        const LgDictionaryPtr& dict,
+                        const std::string& word)
 {
-	if (WORD_NODE != _outgoing[0]->get_type())
+	HandleSeq djs;
+	if (not ldn->entry_cache().lookup(word, dict->serial(), djs))
 	{
-		if (silent) throw SilentException();
-		throw InvalidParamException(TRACE_INFO,
-			"LgDictEntry: Expecting WordNode, got %s",
-			_outgoing[0]->to_string().c_str());
+		djs = getDictEntry(dict->get(), word);
+		ldn->entry_cache().insert(word, dict->serial(), djs);
 	}
+	return djs;
+}
 
+ValuePtr LGDictEntry::execute(AtomSpace* as, bool silent)
+{
 	if (LG_DICT_NODE != _outgoing[1]->get_type())
 	{
 		if (silent) throw SilentException();
 		throw InvalidParamException(TRACE_INFO,
-			"LgDictEntry: Expecting WordNode, got %s",
-			_outgoing[0]->to_string().c_str());
+			"LgDictEntry: Expecting LgDictNode, got %s",
+			_outgoing[1]->to_string().c_str());
 	}
 
+	bool batch;
+	HandleSeq words(get_words(_outgoing[0], as, silent, batch,
+	                          "LgDictEntry"));
+
 	// Get the dictionary
 	LgDictNodePtr ldn(LgDictNodeCast(_outgoing[1]));
-	Dictionary dict = ldn->get_dictionary();
+	LgDictionaryPtr dict = ldn->get_dictionary();
 	if (nullptr == dict)
 		throw InvalidParamException(TRACE_INFO,
 			"LgDictEntry requires valid dictionary! %s was given.",
 			ldn->get_name().c_str());
 
-	HandleSeq djs = getDictEntry(dict, _outgoing[0]->get_name());
-	for (const Handle& dj: djs) as->add_atom(dj);
+	if (not batch)
+	{
+		HandleSeq djs(lookup(ldn, dict, words[0]->get_name()));
 
-	return createLinkValue(djs);
+		HandleSeq added;
+		added.reserve(djs.size());
+		for (const Handle& dj: djs) added.emplace_back(as->add_atom(dj));
+
+		return createLinkValue(added);
+	}
+
+	// The lookups run concurrently; the Atoms they build are free
+	// standing, so that the threads do not contend for the AtomSpace.
+	// A few words are not worth starting threads for.
+	size_t nwords = words.size();
+	std::vector<HandleSeq> djs(nwords);
+	lg_parallel_for(nwords, 0, 8, [&](size_t i, size_t)
+	{
+		djs[i] = lookup(ldn, dict, words[i]->get_name());
+	});
+
+	// Then everything goes into the AtomSpace in one pass. Words have
+	// many disjuncts in common; with the cache on, they are the same
+	// Atoms, and each is added only once.
+	std::unordered_map<const Atom*, Handle> added;
+	ValueSeq results;
+	results.reserve(nwords);
+	for (const HandleSeq& wdjs : djs)
+	{
+		HandleSeq hs;
+		hs.reserve(wdjs.size());
+		for (const Handle& dj: wdjs)
+		{
+			Handle& h = added[dj.get()];
+			if (nullptr == h) h = as->add_atom(dj);
+			hs.emplace_back(h);
+		}
+		results.emplace_back(createLinkValue(std::move(hs)));
+	}
+	return createLinkValue(std::move(results));
 }
 
 DEFINE_LINK_FACTORY(LGDictEntry, LG_DICT_ENTRY)
@@ -126,8 +229,7 @@ void LGHaveDictEntry::init()
 		throw InvalidParamException(TRACE_INFO,
 			"LgHaveDictEntry: Expecting two arguments, got %lu", osz);
 
-	Type pht = oset[0]->get_type();
-	if (WORD_NODE != pht and VARIABLE_NODE != pht and GLOB_NODE != pht)
+	if (not valid_words(oset[0]))
 		throw InvalidParamException(TRACE_INFO,
 			"LgHaveDictEntry: Expecting WordNode, got %s",
 			oset[0]->to_string().c_str());
@@ -154,36 +256,63 @@ LGHaveDictEntry::LGHaveDictEntry(const HandleSeq&& oset, Type t)
 
 // =================================================================
 
-bool LGHaveDictEntry::bevaluate(AtomSpace* as, bool silent)
+/// Look up the words, as given. Sets `batch` if a list was given.
+std::vector<bool> LGHaveDictEntry::have_entries(AtomSpace* as,
+                                                bool silent, bool& batch)
 {
-	if (WORD_NODE != _outgoing[0]->get_type())
-	{
-		if (silent) throw SilentException();
-		throw InvalidParamException(TRACE_INFO,
-			"LgHaveDictEntry: Expecting WordNode, got %s",
-			_outgoing[0]->to_string().c_str());
-	}
-
 	if (LG_DICT_NODE != _outgoing[1]->get_type())
 	{
 		if (silent) throw SilentException();
 		throw InvalidParamException(TRACE_INFO,
-			"LgHaveDictEntry: Expecting WordNode, got %s",
-			_outgoing[0]->to_string().c_str());
+			"LgHaveDictEntry: Expecting LgDictNode, got %s",
+			_outgoing[1]->to_string().c_str());
 	}
 
+	HandleSeq words(get_words(_outgoing[0], as, silent, batch,
+	                          "LgHaveDictEntry"));
+
 	// Get the dictionary
 	LgDictNodePtr ldn(LgDictNodeCast(_outgoing[1]));
-	Dictionary dict = ldn->get_dictionary();
+	LgDictionaryPtr dict = ldn->get_dictionary();
 	if (nullptr == dict)
 		throw InvalidParamException(TRACE_INFO,
 			"LgDictEntry requires valid dictionary! %s was given.",
 			ldn->get_name().c_str());
 
-	if (haveDictEntry(dict, _outgoing[0]->get_name()))
-		return true;
+	// Goes straight to the dictionary, unless the filter is on.
+	LGDictFilter& filter = ldn->word_filter();
+
+	// Each check is quick; only long lists are split up.
+	size_t nwords = words.size();
+	std::vector<char> have(nwords);
+	lg_parallel_for(nwords, 0, 256, [&](size_t i, size_t)
+	{
+		have[i] = filter.is_known(dict, words[i]->get_name());
+	});
+
+	return std::vector<bool>(have.begin(), have.end());
+}
+
+/// True if the dictionary has the word. For a list of words, true if
+/// it has all of them.
+bool LGHaveDictEntry::bevaluate(AtomSpace* as, bool silent)
+{
+	bool batch;
+	for (bool have : have_entries(as, silent, batch))
+		if (not have) return false;
+
+	return true;
+}
+
+/// For a list of words, a BoolValue with one entry per word.
+ValuePtr LGHaveDictEntry::execute(AtomSpace* as, bool silent)
+{
+	bool batch;
+	std::vector<bool> have(have_entries(as, silent, batch));
+	if (batch)
+		return createBoolValue(have);
 
-	return false;
+	return createBoolValue(have[0]);
 }
 
 DEFINE_LINK_FACTORY(LGHaveDictEntry, LG_HAVE_DICT_ENTRY)
@@ -24,6 +24,8 @@
 #ifndef _OPENCOG_LG_DICT_ENTRY_H
 #define _OPENCOG_LG_DICT_ENTRY_H
 
+#include <vector>
+
 #include <link-grammar/link-includes.h>
 
 #include <opencog/atoms/core/FunctionLink.h>
@@ -49,6 +51,10 @@ namespace opencog
 ///
 /// Executing the above will look up the word in the English
 /// dictionary, and place the contents into the AtomSpace.
+///
+/// A ListLink of words may be given instead of a single word; they
+/// are looked up concurrently, and a LinkValue holding one result per
+/// word is returned.
 
 class LGDictEntry : public FunctionLink
 {
@@ -74,10 +80,13 @@ static inline LGDictEntryPtr LGDictEntryCast(AtomPtr a)
 
 #define createLGDictEntry std::make_shared<LGDictEntry>
 
+/// True if the word is in the dictionary. Given a ListLink of words,
+/// executing it returns a BoolValue, with one entry per word.
 class LGHaveDictEntry : public EvaluatableLink
 {
 protected:
 	void init();
+	std::vector<bool> have_entries(AtomSpace*, bool, bool&);
 
 public:
 	LGHaveDictEntry(const HandleSeq&&, Type=LG_HAVE_DICT_ENTRY);
@@ -86,6 +95,7 @@ public:
 
 	virtual bool is_evaluatable() const { return true; }
 	virtual bool bevaluate(AtomSpace*, bool);
+	virtual ValuePtr execute(AtomSpace*, bool);
 
 	static Handle factory(const Handle&);
 };
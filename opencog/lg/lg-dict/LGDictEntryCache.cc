@@ -0,0 +1,234 @@
+/*
+ * LGDictEntryCache.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/base/Node.h>
+#include "LGDictEntryCache.h"
+
+using namespace opencog;
+
+// Default limits. Enough for the working vocabulary of a generator,
+// but not for a whole dictionary.
+#define DEFAULT_MAX_ENTRIES 4096
+#define DEFAULT_MAX_BYTES (128UL * 1024 * 1024)
+
+// Shared Atoms that no entry holds anymore are dropped when there are
+// more than this many, or twice as many as after the last time.
+#define MIN_PRUNE_AT 16384
+
+/// Rough estimate of the memory held by an Atom itself, not counting
+/// the Atoms in its outgoing set; those are shared, and are counted
+/// on their own.
+static size_t atom_bytes(const Handle& h)
+{
+	if (h->is_node())
+		return sizeof(Node) + h->get_name().size();
+
+	return sizeof(Link) + sizeof(Handle) * h->get_arity();
+}
+
+LGDictEntryCache::LGDictEntryCache(void) :
+	_max_entries(DEFAULT_MAX_ENTRIES), _max_bytes(DEFAULT_MAX_BYTES),
+	_prune_at(MIN_PRUNE_AT)
+{
+}
+
+/// Set the maximum number of entries, and the maximum estimated
+/// memory use, in bytes. Setting zero entries turns the cache off,
+/// and empties it. Setting zero bytes means no memory limit.
+void LGDictEntryCache::set_limits(size_t max_entries, size_t max_bytes)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_max_entries = max_entries;
+	_max_bytes = max_bytes;
+	evict();
+	if (0 == _max_entries)
+	{
+		_atoms.clear();
+		_stats.bytes = 0;
+	}
+	else prune();
+}
+
+/// Drop the least-recently-used entry. Its Atoms stay, until pruned.
+/// Caller must hold the lock.
+void LGDictEntryCache::drop_oldest(void)
+{
+	Entry& old = _lru.back();
+	_stats.bytes -= old.bytes;
+	_index.erase(old.word);
+	_lru.pop_back();
+	_stats.evictions++;
+}
+
+/// Drop least-recently-used entries until under the limits. The Atoms
+/// of the dropped entries are counted until they are pruned, so, when
+/// over the memory limit, drop a batch at a time and then prune.
+/// Caller must hold the lock.
+void LGDictEntryCache::evict(void)
+{
+	while (_max_entries < _lru.size())
+		drop_oldest();
+
+	while (0 < _lru.size() and 0 < _max_bytes and _max_bytes < _stats.bytes)
+	{
+		size_t batch = std::max((size_t) 1, _lru.size() / 16);
+		for (size_t i=0; i<batch; i++)
+			drop_oldest();
+		prune();
+	}
+	_stats.entries = _lru.size();
+}
+
+bool LGDictEntryCache::lookup(const std::string& word, size_t serial,
+                              HandleSeq& djs)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	auto it = _index.find(word);
+	if (_index.end() == it or it->second->serial != serial)
+	{
+		_stats.misses++;
+		return false;
+	}
+
+	// Move to the front.
+	_lru.splice(_lru.begin(), _lru, it->second);
+	_stats.hits++;
+	djs = _lru.front().djs;
+	return true;
+}
+
+/// Return the cached copy of the Atom, adding it if there is none.
+/// Within a lookup, the Atoms are already unique, so each one needs to
+/// be looked at only once. Caller must hold the lock.
+Handle LGDictEntryCache::share(const Handle& h,
+                               std::unordered_map<const Atom*, Handle>& done)
+{
+	auto dit = done.find(h.get());
+	if (done.end() != dit) return dit->second;
+
+	Handle shared;
+	auto it = _atoms.find(h);
+	if (_atoms.end() != it)
+		shared = *it;
+	else if (h->is_node())
+	{
+		shared = *_atoms.insert(h).first;
+		_stats.bytes += atom_bytes(shared);
+	}
+	else
+	{
+		// Share the parts, too.
+		bool same = true;
+		HandleSeq oset;
+		oset.reserve(h->get_arity());
+		for (const Handle& ho : h->getOutgoingSet())
+		{
+			oset.emplace_back(share(ho, done));
+			if (oset.back() != ho) same = false;
+		}
+		shared = same ? h : createLink(std::move(oset), h->get_type());
+		_atoms.insert(shared);
+		_stats.bytes += atom_bytes(shared);
+	}
+
+	done.emplace(h.get(), shared);
+	return shared;
+}
+
+/// Drop the shared Atoms that are held by nothing else, neither by
+/// entries, nor by other shared Atoms, nor by anyone outside of the
+/// cache. Caller must hold the lock.
+void LGDictEntryCache::prune(void)
+{
+	size_t before;
+	do
+	{
+		before = _atoms.size();
+		for (auto it = _atoms.begin(); it != _atoms.end(); )
+		{
+			if (1 == it->use_count())
+			{
+				_stats.bytes -= atom_bytes(*it);
+				it = _atoms.erase(it);
+			}
+			else it++;
+		}
+	}
+	while (_atoms.size() < before);
+
+	_prune_at = std::max((size_t) MIN_PRUNE_AT, 2 * _atoms.size());
+}
+
+void LGDictEntryCache::insert(const std::string& word, size_t serial,
+                              HandleSeq& djs)
+{
+	// The entry itself; the Atoms are counted as they are shared.
+	size_t bytes = 2 * word.size() + sizeof(Entry) +
+		sizeof(Handle) * djs.size();
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	if (0 == _max_entries) return;
+
+	// Some other thread may have looked up the same word. Serial
+	// numbers only go up; a lookup that started before a reload must
+	// not replace the entry made with the reloaded dictionary.
+	auto it = _index.find(word);
+	if (_index.end() != it)
+	{
+		if (serial < it->second->serial) return;
+		_stats.bytes -= it->second->bytes;
+		_lru.erase(it->second);
+		_index.erase(it);
+	}
+
+	std::unordered_map<const Atom*, Handle> done;
+	for (Handle& h : djs)
+		h = share(h, done);
+
+	_lru.push_front({word, serial, djs, bytes});
+	_index[word] = _lru.begin();
+	_stats.bytes += bytes;
+	evict();
+
+	if (_prune_at < _atoms.size()) prune();
+}
+
+void LGDictEntryCache::clear(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_lru.clear();
+	_index.clear();
+	_atoms.clear();
+	_prune_at = MIN_PRUNE_AT;
+	_stats.bytes = 0;
+	_stats.entries = 0;
+}
+
+LGDictEntryCache::Stats LGDictEntryCache::get_stats(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	return _stats;
+}
+
+/* ===================== END OF FILE ===================== */
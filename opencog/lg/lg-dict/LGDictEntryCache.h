@@ -0,0 +1,122 @@
+/*
+ * LGDictEntryCache.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LG_DICT_ENTRY_CACHE_H
+#define _OPENCOG_LG_DICT_ENTRY_CACHE_H
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// Bounded LRU cache of dictionary entries, one per LgDictNode.
+///
+/// Looking up a word means walking its expression tree, expanding it
+/// to disjunctive normal form, and building the Atoms for it. Text
+/// generation looks up the same few thousand words over and over.
+/// This cache maps a word to the disjuncts built for it the first
+/// time. Each entry remembers the serial number of the dictionary
+/// copy (see LgDictionary) that it came from, and is good only for
+/// that copy; the whole cache is emptied when the dictionary is
+/// reloaded. It is bounded both by the number of entries and by an
+/// estimate of the memory they use.
+///
+/// Different words have most of their connectors, and many of their
+/// disjuncts, in common. The cache keeps one copy of each: an Atom
+/// that some cached word already holds is shared with that word,
+/// rather than kept twice. The memory estimate counts each of these
+/// copies once, however many words hold it.
+class LGDictEntryCache
+{
+public:
+	struct Stats
+	{
+		size_t hits = 0;
+		size_t misses = 0;
+		size_t evictions = 0;
+		size_t entries = 0;
+		size_t bytes = 0;
+	};
+
+private:
+	struct Entry
+	{
+		std::string word;
+		size_t serial;
+		HandleSeq djs;
+		size_t bytes;
+	};
+
+	std::mutex _mtx;
+	std::list<Entry> _lru;  // Most recently used first.
+	std::unordered_map<std::string, std::list<Entry>::iterator> _index;
+
+	size_t _max_entries;
+	size_t _max_bytes;
+	Stats _stats;
+
+	// The Atoms held by cached entries, one copy of each.
+	struct ContentHash
+	{
+		size_t operator()(const Handle& h) const { return h->get_hash(); }
+	};
+	struct ContentEq
+	{
+		bool operator()(const Handle& a, const Handle& b) const
+		{ return *a == *b; }
+	};
+	std::unordered_set<Handle, ContentHash, ContentEq> _atoms;
+	size_t _prune_at;
+
+	void evict(void);
+	void drop_oldest(void);
+	Handle share(const Handle&, std::unordered_map<const Atom*, Handle>&);
+	void prune(void);
+
+public:
+	LGDictEntryCache(void);
+
+	void set_limits(size_t max_entries, size_t max_bytes);
+
+	// Return true, and the disjuncts, if the word is in the cache,
+	// for the dictionary with this serial number.
+	bool lookup(const std::string&, size_t, HandleSeq&);
+
+	// Add the disjuncts of the word. Atoms that the cache already
+	// holds are replaced by the cached copies, in place.
+	void insert(const std::string&, size_t, HandleSeq&);
+	void clear(void);
+
+	Stats get_stats(void);
+};
+
+/** @}*/
+}
+#endif // _OPENCOG_LG_DICT_ENTRY_CACHE_H
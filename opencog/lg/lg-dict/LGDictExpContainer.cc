@@ -22,6 +22,7 @@
  */
 
 #include <algorithm>
+#include <unordered_set>
 
 #include <opencog/util/oc_assert.h>
 
@@ -33,31 +34,74 @@
 using namespace opencog;
 
 /**
- * Constructor for CONNECTOR_type.
+ * Constructor.  Builds the flattened DNF of the LG expression tree.
  *
- * @param t     must be CONNECTOR_type
  * @param exp   pointer to the LG Exp structure
  */
-LGDictExpContainer::LGDictExpContainer(Exp_type t, const Exp* exp)
-    : m_type(t)
+LGDictExpContainer::LGDictExpContainer(const Exp* exp)
 {
-    if (t != CONNECTOR_type)
-        throw InvalidParamException(TRACE_INFO,
-            "Expected CONNECTOR_type for expression type.");
+    m_root = build(exp);
+}
+
+/**
+ * Copy the LG expression tree into the arena, bottom-up.
+ *
+ * @param exp   the input expression tree
+ * @return      index of the (normalized) copy
+ */
+LGDictExpContainer::Index LGDictExpContainer::build(const Exp* exp)
+{
+    if (CONNECTOR_type == exp->type)
+        return make_connector(exp);
+
+    std::vector<Index> subcontainers;
+
+    // FIXME XXX -- Optionals are handled incorrectly here;
+    // they are denoted by a null Exp pointer in an OR_list!
+    // Ignoring all the nulls is just ... wrong.
+#if (LINK_MAJOR_VERSION == 5) &&  (LINK_MINOR_VERSION < 7)
+    E_list* el = exp->u.l;
+    while (el)
+    {
+        subcontainers.push_back(build(el->e));
+        el = el->next;
+    }
+#else
+    const Exp* subexp = lg_exp_operand_first((Exp*) exp);
+    while (subexp)
+    {
+        subcontainers.push_back(build(subexp));
+        subexp = lg_exp_operand_next((Exp*) subexp);
+    }
+#endif
+
+    return make(exp->type, std::move(subcontainers));
+}
+
+/**
+ * Add a connector.
+ *
+ * @param exp   pointer to the LG Exp structure, of CONNECTOR_type
+ * @return      index of the new node
+ */
+LGDictExpContainer::Index LGDictExpContainer::make_connector(const Exp* exp)
+{
+    Node n;
+    n.m_type = CONNECTOR_type;
 
     // fill stuff with fixed junk for the OPTIONAL connector
     if (exp == NULL)
     {
-        m_string = "OPTIONAL";
-        m_direction = '+';
-        m_multi = false;
-        return;
+        n.m_string = "OPTIONAL";
+        n.m_direction = '+';
+        n.m_multi = false;
     }
-
+    else
+    {
 #if (LINK_MAJOR_VERSION == 5) && (LINK_MINOR_VERSION == 4) && (LINK_MICRO_VERSION < 4)
-    m_string = exp->u.string;
-    m_direction = exp->dir;
-    m_multi = exp->multi;
+        n.m_string = exp->u.string;
+        n.m_direction = exp->dir;
+        n.m_multi = exp->multi;
 #endif
 
 #if (LINK_MAJOR_VERSION == 5) && (LINK_MINOR_VERSION == 4) && (LINK_MICRO_VERSION == 4)
@@ -65,132 +109,141 @@ LGDictExpContainer::LGDictExpContainer(Exp_type t, const Exp* exp)
 #endif
 
 #if (LINK_MAJOR_VERSION == 5) && (LINK_MINOR_VERSION >= 5)
-    m_string = lg_exp_get_string(exp);
-    m_direction = lg_exp_get_dir(exp);
-    m_multi = lg_exp_get_multi(exp);
+        n.m_string = lg_exp_get_string(exp);
+        n.m_direction = lg_exp_get_dir(exp);
+        n.m_multi = lg_exp_get_multi(exp);
 #endif
+    }
+
+    m_nodes.emplace_back(std::move(n));
+    return m_nodes.size() - 1;
 }
 
 /**
- * Constructor for AND_type and OR_type.  Always return flatten DNF.
+ * Add an AND_type or OR_type node.  Always results in flatten DNF.
+ *
+ * The sub-expressions must already be in flatten DNF.  If the node
+ * flattens away to one of its sub-expressions, no new node is added,
+ * and the index of that sub-expression is returned.
+ *
+ * Connectors are OR-distributive but not AND-distributive. Thus, while
+ * (A & (B or C)) = ((A & B) or (A & C)), it is NOT the case that
+ * (A or (B & C)) = ((A or B) & (A or C)).
  *
- * @param t    AND_type or OR_type
- * @param s    vector of next level's containers
+ * @param t      AND_type or OR_type
+ * @param subs   indexes of the next level's nodes
+ * @return       index of the resulting node
  */
-LGDictExpContainer::LGDictExpContainer(Exp_type t,
-                                       const std::vector<LGDictExpContainer> &s)
-    : m_type(t), m_subexps(s)
+LGDictExpContainer::Index LGDictExpContainer::make(Exp_type t,
+                                                   std::vector<Index>&& subs)
 {
     if (t != AND_type && t != OR_type)
         throw InvalidParamException(TRACE_INFO,
             "Expected AND_type/OR_type for expression type.");
 
-    // flatten & dnf on construction
-    basic_flatten();
-    basic_dnf();
+    // flatten
+    if (basic_flatten(t, subs))
+        return subs[0];
+
+    // dnf; assuming sub-level already in dnf, then OR is done
+    if (t == AND_type)
+    {
+        // find the first OR to distribute
+        auto or_exp_it = std::find_if(subs.begin(), subs.end(),
+            [&](Index i) { return m_nodes[i].m_type == OR_type; });
+
+        if (or_exp_it != subs.end())
+        {
+            Index or_exp = *or_exp_it;
+            subs.erase(or_exp_it);
+
+            // Change the type of this node to OR, and distribute the
+            // stuff in or_exp.  The arena grows as we go; take a copy
+            // of the OR's indexes, rather than a reference into it.
+            std::vector<Index> branches(m_nodes[or_exp].m_subexps);
+            std::vector<Index> ors;
+            ors.reserve(branches.size());
+            for (Index e : branches)
+            {
+                std::vector<Index> conj;
+                conj.reserve(subs.size() + 1);
+                conj = subs;
+
+                // don't bother distributing the optional connector
+                if (not is_optional(e))
+                    conj.push_back(e);
+
+                ors.push_back(make(AND_type, std::move(conj)));
+            }
+
+            t = OR_type;
+            subs = std::move(ors);
+        }
+    }
 
     // need flattening again after changing to dnf
-    basic_flatten();
+    if (basic_flatten(t, subs))
+        return subs[0];
 
     // convert to normal order (- before +)
-    basic_normal_order();
+    if (t == AND_type)
+        basic_normal_order(subs);
+
+    Node n;
+    n.m_type = t;
+    n.m_direction = '+';
+    n.m_multi = false;
+    n.m_subexps = std::move(subs);
+    m_nodes.emplace_back(std::move(n));
+    return m_nodes.size() - 1;
 }
 
 /**
- * Flatten the container.
+ * Flatten the list of sub-expressions of a node of type t.
  *
  * Remove nested and-recursive trees. Thus, AND(A, AND(B, C)) becomes
  * AND(A, B, C), assuming the sub-levels are already flattened.
+ *
+ * @return   true if there is only one sub-expression, so that this
+ *           level is not needed; the list is then left as it is.
  */
-void LGDictExpContainer::basic_flatten()
+bool LGDictExpContainer::basic_flatten(Exp_type t, std::vector<Index>& subs)
 {
-    std::vector<LGDictExpContainer> new_subexps;
-
     // do not need this level if only one sub-expression
-    if (m_subexps.size() == 1)
-    {
-        m_type = m_subexps[0].m_type;
-
-        if (m_type == CONNECTOR_type)
-        {
-            m_string = m_subexps[0].m_string;
-            m_direction = m_subexps[0].m_direction;
-            m_multi = m_subexps[0].m_multi;
-        }
-        else
-        {
-            m_subexps = m_subexps[0].m_subexps;
-        }
+    if (subs.size() == 1)
+        return true;
 
-        return;
-    }
+    // nothing to merge; leave it in place
+    if (std::none_of(subs.begin(), subs.end(),
+            [&](Index i) { return m_nodes[i].m_type == t; }))
+        return false;
 
-    for (LGDictExpContainer& exp : m_subexps)
+    std::vector<Index> new_subexps;
+    new_subexps.reserve(subs.size());
+    for (Index i : subs)
     {
+        const Node& exp = m_nodes[i];
+
         // cannot merge diffenent type
-        if (m_type != exp.m_type)
+        if (t != exp.m_type)
         {
-            new_subexps.push_back(exp);
+            new_subexps.push_back(i);
             continue;
         }
 
         // bring things up a level, assuming the sub-level is already flat
-        for (LGDictExpContainer& subexp : exp.m_subexps)
-            new_subexps.push_back(subexp);
+        new_subexps.insert(new_subexps.end(),
+                           exp.m_subexps.begin(), exp.m_subexps.end());
     }
 
-    m_subexps = new_subexps;
+    subs = std::move(new_subexps);
+    return false;
 }
 
-/**
- * Construct disjunctive normal form.
- *
- * Convert the expression into DNF form (ie. a disjuction of
- * conjunctions of connectors).
- *
- * Connectors are OR-distributive but not AND-distributive. Thus, while
- * (A & (B or C)) = ((A & B) or (A & C)), it is NOT the case that
- * (A or (B & C)) = ((A or B) & (A or C)).
- */
-void LGDictExpContainer::basic_dnf()
+bool LGDictExpContainer::is_optional(Index i) const
 {
-    std::vector<LGDictExpContainer> new_subexps(m_subexps);
-
-    // assuming sub-level already in dnf, then OR can just be returned
-    if (m_type == OR_type)
-        return;
-
-    // find the first OR to distribute
-    auto or_exp_it = std::find_if(new_subexps.begin(),
-                                  new_subexps.end(),
-           [](LGDictExpContainer& exp) { return exp.m_type == OR_type; });
-
-    // no OR, the end
-    if (or_exp_it == new_subexps.end())
-        return;
-
-    // copy the OR exp out, then remove it from the list
-    LGDictExpContainer or_exp = *or_exp_it;
-    new_subexps.erase(or_exp_it);
-
-    // Change the type of this container to OR, and distribute
-    // the stuff in or_exp
-    m_type = OR_type;
-    m_subexps.clear();
-
-    for (auto& e : or_exp.m_subexps)
-    {
-        // don't bother distributing the optional connector, just clone
-        if (e.m_type == CONNECTOR_type && e.m_string == "OPTIONAL")
-        {
-            m_subexps.push_back(LGDictExpContainer(AND_type, new_subexps));
-            continue;
-        }
-
-        new_subexps.push_back(e);
-        m_subexps.push_back(LGDictExpContainer(AND_type, new_subexps));
-        new_subexps.pop_back();
-    }
+    const Node& n = m_nodes[i];
+    return n.m_type == CONNECTOR_type && n.m_string == "OPTIONAL";
 }
 
 /**
@@ -199,82 +252,94 @@ void LGDictExpContainer::basic_dnf()
  * Putting connectors with - direction before those with + direction.
  * Assume everything already in DNF.
  */
-void LGDictExpContainer::basic_normal_order()
+void LGDictExpContainer::basic_normal_order(std::vector<Index>& subs)
 {
-    // do nothing for OR
-    if (m_type == OR_type)
-        return;
+    std::stable_partition(subs.begin(), subs.end(),
+        [&](Index i) { return m_nodes[i].m_direction == '-'; });
+}
 
-    std::vector<LGDictExpContainer> new_leftexps;
-    std::vector<LGDictExpContainer> new_rightexps;
+/**
+ * Create the OpenCog atoms for the LG dictionary expression.
+ *
+ * Each distinct connector and connector sequence is built only once;
+ * see LGDictInterner.  The disjuncts are returned in the order that
+ * they are first found, without repeats.
+ *
+ * @param hWordNode  the word
+ * @param intern     the table to build the atoms with
+ * @return           the disjuncts
+ */
+HandleSeq LGDictExpContainer::to_handle(const Handle& hWordNode,
+                                        LGDictInterner& intern)
+{
+    std::vector<Handle> memo(m_nodes.size());
+    return to_handle(m_root, intern, memo);
+}
 
-    for (auto& exp : m_subexps)
+HandleSeq LGDictExpContainer::to_handle(const Handle& hWordNode)
+{
+    LGDictInterner intern;
+    return to_handle(hWordNode, intern);
+}
+
+HandleSeq LGDictExpContainer::to_handle(Index i, LGDictInterner& intern,
+                                        std::vector<Handle>& memo)
+{
+    if (m_nodes[i].m_type != OR_type)
+        return { to_atom(i, intern, memo) };
+
+    // OR_type returns the collected disjuncts.  They are interned, so
+    // that equal disjuncts are the same atom.
+    HandleSeq outgoing;
+    std::unordered_set<const Atom*> seen;
+    for (Index sub : m_nodes[i].m_subexps)
     {
-        if (exp.m_direction == '-')
-            new_leftexps.push_back(exp);
-        else
-            new_rightexps.push_back(exp);
+        for (const Handle& h : to_handle(sub, intern, memo))
+        {
+            if (seen.insert(h.get()).second)
+                outgoing.push_back(h);
+        }
     }
-
-    m_subexps = new_leftexps;
-    m_subexps.insert(m_subexps.end(),
-                     new_rightexps.begin(),
-                     new_rightexps.end());
+    return outgoing;
 }
 
 /**
- * Create the OpenCog atom for the LG dictionary expression.
- *
- * @param as   pointer to the AtomSpace
- * @return     handle to the atom
+ * The atom for a connector or an AND_type node.  A node shared by
+ * many disjuncts is converted once.
  */
-HandleSeq LGDictExpContainer::to_handle(const Handle& hWordNode)
+Handle LGDictExpContainer::to_atom(Index i, LGDictInterner& intern,
+                                   std::vector<Handle>& memo)
 {
-    static Handle multi(createNode(LG_CONN_MULTI_NODE, "@"));
     static Handle optnl(createLink(LG_CONNECTOR,
                            Handle(createNode(LG_CONN_NODE, "0"))));
 
-    if (m_type == CONNECTOR_type)
+    if (memo[i]) return memo[i];
+
+    const Node& n = m_nodes[i];
+    if (n.m_type == CONNECTOR_type)
     {
         // XXX FIXME this does not smell right; optionals should get
         // blown up into pairs of disjuncts, one with and one without.
-        if (m_string == "OPTIONAL") return { optnl };
-
-        Handle connector(createNode(LG_CONN_NODE,
-                                    std::move(std::string(m_string))));
-        Handle direction(createNode(LG_CONN_DIR_NODE,
-                          std::move(std::string(1, m_direction))));
+        if (n.m_string == "OPTIONAL") return optnl;
 
-        if (m_multi)
-            return { Handle(createLink(LG_CONNECTOR, connector, direction, multi)) };
-        else
-            return { Handle(createLink(LG_CONNECTOR, connector, direction)) };
+        memo[i] = intern.connector(n.m_string, n.m_direction, n.m_multi);
+        return memo[i];
     }
 
-    HandleSeq outgoing;
-
-    for (auto& exp: m_subexps)
+    if (n.m_type == AND_type)
     {
-        HandleSeq q = exp.to_handle(hWordNode);
-        outgoing.insert(outgoing.end(), q.begin(), q.end());
-    }
-
-    if (m_type == AND_type)
-        return { Handle(createLink(std::move(outgoing), CONNECTOR_SEQ)) };
-
-    // OR_type returns the collected disjuncts
-    if (m_type == OR_type)
-    {
-        // XXX FIXME ... using an std::map would be more efficient.
-        std::sort(outgoing.begin(), outgoing.end());
-        outgoing.erase(std::unique(outgoing.begin(),
-                                   outgoing.end()),
-                                   outgoing.end());
-
-        return outgoing;
+        HandleSeq outgoing;
+        outgoing.reserve(n.m_subexps.size());
+        for (Index sub : n.m_subexps)
+        {
+            HandleSeq q = to_handle(sub, intern, memo);
+            outgoing.insert(outgoing.end(), q.begin(), q.end());
+        }
+        memo[i] = intern.conseq(std::move(outgoing));
+        return memo[i];
     }
 
     // Should never get here
-    OC_ASSERT(false, "Unknown Link Grammar Expression type %d", m_type);
-    return HandleSeq();
+    OC_ASSERT(false, "Unknown Link Grammar Expression type %d", n.m_type);
+    return Handle::UNDEFINED;
 }
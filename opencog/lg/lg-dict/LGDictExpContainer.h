@@ -24,9 +24,13 @@
 #ifndef _OPENCOG_LG_DICT_EXP_H
 #define _OPENCOG_LG_DICT_EXP_H
 
+#include <cstdint>
+#include <vector>
+
 #include <link-grammar/dict-api.h>
 
 #include <opencog/atomspace/AtomSpace.h>
+#include <opencog/lg/lg-dict/LGDictInterner.h>
 
 
 namespace opencog
@@ -36,27 +40,55 @@ namespace opencog
  * Link Grammar expression container.
  *
  * A helper class for doing operations on LG expression.
+ *
+ * The expression tree is held in an arena: the nodes live in one
+ * vector, and refer to their children by index. Once built, a node is
+ * never changed, so that a subtree that appears in many places (as it
+ * does, after DNF expansion) is stored only once, and is shared by
+ * index, instead of being copied. The container is built for a single
+ * lookup; it can be moved, but not copied.
  */
 class LGDictExpContainer
 {
 public:
-    LGDictExpContainer(Exp_type, const Exp* exp);
-    LGDictExpContainer(Exp_type, const std::vector<LGDictExpContainer>&);
+    LGDictExpContainer(const Exp* exp);
+    LGDictExpContainer(LGDictExpContainer&&) = default;
+    LGDictExpContainer& operator=(LGDictExpContainer&&) = default;
+    LGDictExpContainer(const LGDictExpContainer&) = delete;
+    LGDictExpContainer& operator=(const LGDictExpContainer&) = delete;
 
     HandleSeq to_handle(const Handle& h);
+    HandleSeq to_handle(const Handle& h, LGDictInterner&);
 
 private:
-    void basic_flatten();
-    void basic_dnf();
-    void basic_normal_order();
+    typedef uint32_t Index;
+
+    struct Node
+    {
+        Exp_type m_type;
+
+        // For CONNECTOR_type only.
+        std::string m_string;
+        char m_direction;
+        bool m_multi;
+
+        // For AND_type and OR_type only.
+        std::vector<Index> m_subexps;
+    };
+
+    Index build(const Exp* exp);
+    Index make_connector(const Exp* exp);
+    Index make(Exp_type, std::vector<Index>&&);
 
-    Exp_type m_type;
+    bool basic_flatten(Exp_type, std::vector<Index>&);
+    bool is_optional(Index) const;
+    void basic_normal_order(std::vector<Index>&);
 
-    std::string m_string;
-    char m_direction;
-    bool m_multi;
+    HandleSeq to_handle(Index, LGDictInterner&, std::vector<Handle>&);
+    Handle to_atom(Index, LGDictInterner&, std::vector<Handle>&);
 
-    std::vector<LGDictExpContainer> m_subexps;
+    std::vector<Node> m_nodes;
+    Index m_root;
 };
 
 }
@@ -0,0 +1,193 @@
+/*
+ * LGDictExport.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <chrono>
+
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/base/Node.h>
+#include <opencog/atoms/core/NumberNode.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/persist/api/StorageNode.h>
+#include <opencog/util/exceptions.h>
+#include "LGDictNode.h"
+#include "LGDictExport.h"
+#include "LGDictReader.h"
+#include "LGParallelFor.h"
+
+using namespace opencog;
+
+#define DEFAULT_BATCH_SIZE 1000
+
+void LGDictExport::init()
+{
+	const HandleSeq& oset = _outgoing;
+
+	size_t osz = oset.size();
+	if (1 > osz or 3 < osz)
+		throw InvalidParamException(TRACE_INFO,
+			"LgDictExport: Expecting one to three arguments, got %lu", osz);
+
+	Type dit = oset[0]->get_type();
+	if (LG_DICT_NODE != dit and VARIABLE_NODE != dit and GLOB_NODE != dit)
+		throw InvalidParamException(TRACE_INFO,
+			"LgDictExport: Expecting LgDictNode, got %s",
+			oset[0]->to_string().c_str());
+
+	for (size_t i=1; i<osz; i++)
+	{
+		Type t = oset[i]->get_type();
+		if (not nameserver().isA(t, STORAGE_NODE) and
+		    NUMBER_NODE != t and VARIABLE_NODE != t and GLOB_NODE != t)
+			throw InvalidParamException(TRACE_INFO,
+				"LgDictExport: Expecting StorageNode or NumberNode, got %s",
+				oset[i]->to_string().c_str());
+	}
+}
+
+LGDictExport::LGDictExport(const HandleSeq&& oset, Type t)
+	: FunctionLink(std::move(oset), t)
+{
+	// Type must be as expected
+	if (not nameserver().isA(t, LG_DICT_EXPORT))
+	{
+		const std::string& tname = nameserver().getTypeName(t);
+		throw InvalidParamException(TRACE_INFO,
+			"Expecting an LgDictExport, got %s", tname.c_str());
+	}
+	init();
+}
+
+// =================================================================
+
+ValuePtr LGDictExport::execute(AtomSpace* as, bool silent)
+{
+	static const Handle progress_key(
+		createNode(PREDICATE_NODE, "*-lg-export-progress-*"));
+
+	if (LG_DICT_NODE != _outgoing[0]->get_type())
+	{
+		if (silent) throw SilentException();
+		throw InvalidParamException(TRACE_INFO,
+			"LgDictExport: Expecting LgDictNode, got %s",
+			_outgoing[0]->to_string().c_str());
+	}
+
+	StorageNodePtr stnp;
+	size_t batch_size = DEFAULT_BATCH_SIZE;
+	for (size_t i=1; i<_outgoing.size(); i++)
+	{
+		const Handle& h = _outgoing[i];
+		if (nameserver().isA(h->get_type(), STORAGE_NODE))
+			stnp = StorageNodeCast(h);
+		else if (NUMBER_NODE == h->get_type())
+		{
+			double bs = NumberNodeCast(h)->get_value();
+			if (1.0 <= bs) batch_size = bs;
+		}
+		else
+		{
+			if (silent) throw SilentException();
+			throw InvalidParamException(TRACE_INFO,
+				"LgDictExport: Expecting StorageNode or NumberNode, got %s",
+				h->to_string().c_str());
+		}
+	}
+
+	if (stnp and not stnp->connected())
+		throw RuntimeException(TRACE_INFO,
+			"LgDictExport: StorageNode is not open: %s",
+			stnp->to_short_string().c_str());
+
+	// Get the dictionary
+	LgDictNodePtr ldn(LgDictNodeCast(_outgoing[0]));
+	LgDictionaryPtr dict = ldn->get_dictionary();
+	if (nullptr == dict)
+		throw InvalidParamException(TRACE_INFO,
+			"LgDictExport requires valid dictionary! %s was given.",
+			ldn->get_name().c_str());
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::string> words(getDictWords(dict->get()));
+	size_t nwords = words.size();
+	size_t ndone = 0;
+	size_t ndjs = 0;
+
+	auto report = [&]()
+	{
+		double secs = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+		ValuePtr counts(createFloatValue(std::vector<double>({
+			(double) ndone, (double) nwords, (double) ndjs, secs,
+			(0.0 < secs) ? ndjs / secs : 0.0})));
+		setValue(progress_key, counts);
+		return counts;
+	};
+	report();
+
+	// Backends want the Atoms that they store to be in an AtomSpace.
+	// Each batch goes into a scratch AtomSpace, and is cleared out of
+	// it once written, so that memory use stays bounded.
+	AtomSpacePtr scratch;
+	if (stnp) scratch = createAtomSpace();
+
+	// The entry cache is bypassed; filling it with the whole
+	// dictionary would only push out the words that are in use.
+	std::vector<HandleSeq> sections;
+	while (ndone < nwords)
+	{
+		size_t nbatch = std::min(batch_size, nwords - ndone);
+		sections.assign(nbatch, HandleSeq());
+		lg_parallel_for(nbatch, 0, 8, [&](size_t i, size_t)
+		{
+			const std::string& word = words[ndone + i];
+			Handle hword(createNode(WORD_NODE, std::string(word)));
+			for (const Handle& dj : getDictEntry(dict->get(), word))
+				sections[i].emplace_back(createLink(LG_DISJUNCT, hword, dj));
+		});
+
+		for (const HandleSeq& secs : sections)
+		{
+			for (const Handle& sec : secs)
+			{
+				if (stnp) stnp->store_atom(scratch->add_atom(sec));
+				else as->add_atom(sec);
+			}
+			ndjs += secs.size();
+		}
+		if (stnp)
+		{
+			stnp->barrier();
+			scratch->clear();
+		}
+
+		ndone += nbatch;
+		report();
+	}
+
+	return report();
+}
+
+DEFINE_LINK_FACTORY(LGDictExport, LG_DICT_EXPORT)
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,78 @@
+/*
+ * LGDictExport.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LG_DICT_EXPORT_H
+#define _OPENCOG_LG_DICT_EXPORT_H
+
+#include <opencog/atoms/core/FunctionLink.h>
+#include <opencog/lg/types/atom_types.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// Export a whole Link Grammar dictionary to Atomese.
+///
+/// Usage:
+///
+///     LgDictExport
+///         LgDictNode "en"
+///         RocksStorageNode "rocks:///tmp/en-dict"  -- optional
+///         NumberNode 1000                          -- optional
+///
+/// Executing it looks up every word in the dictionary, and writes an
+/// LgDisjunct for each disjunct of each word, either into the current
+/// AtomSpace or, if a StorageNode is given, to that StorageNode. The
+/// StorageNode must be open; the disjuncts are not placed in the
+/// current AtomSpace, but in a scratch AtomSpace that is emptied after
+/// each batch is written. The words are done in batches of
+/// the given size, 1000 by default; the disjuncts of a batch are built
+/// concurrently, written out, and then let go of, before the next
+/// batch is started.
+///
+/// While it runs, its progress is kept as a FloatValue on the link,
+/// under the key (PredicateNode "*-lg-export-progress-*"). It holds
+/// the number of words done, the total number of words, the number of
+/// disjuncts written, the seconds elapsed, and the disjuncts per
+/// second. The final counts are also returned.
+class LGDictExport : public FunctionLink
+{
+protected:
+	void init();
+
+public:
+	LGDictExport(const HandleSeq&&, Type=LG_DICT_EXPORT);
+	LGDictExport(const LGDictExport&) = delete;
+	LGDictExport& operator=(const LGDictExport&) = delete;
+
+	virtual ValuePtr execute(AtomSpace*, bool);
+
+	static Handle factory(const Handle&);
+};
+
+LINK_PTR_DECL(LGDictExport)
+#define createLGDictExport CREATE_DECL(LGDictExport)
+
+/** @}*/
+}
+#endif // _OPENCOG_LG_DICT_EXPORT_H
@@ -0,0 +1,417 @@
+/*
+ * LGDictFilter.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cctype>
+#include <fstream>
+#include <functional>
+#include <sstream>
+
+#include <opencog/util/Logger.h>
+#include "LGDictFilter.h"
+#include "LGDictReader.h"
+
+using namespace opencog;
+
+// About ten bits per word, and seven probes, for a false-positive
+// rate just under one percent.
+#define BITS_PER_WORD 10
+#define NUM_PROBES 7
+
+// Number of slots in the known-word cache.
+#define KNOWN_SLOTS 1024
+
+static uint64_t word_hash(const std::string& word)
+{
+	return std::hash<std::string>()(word);
+}
+
+// Second, independent hash, derived from the first (splitmix64).
+// It must be odd, so that the probes cover the whole table.
+static uint64_t step_hash(uint64_t h)
+{
+	h += 0x9e3779b97f4a7c15ULL;
+	h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+	return (h ^ (h >> 31)) | 1;
+}
+
+bool LGDictFilter::Bloom::maybe(uint64_t h) const
+{
+	uint64_t nbits = 64 * bits.size();
+	uint64_t step = step_hash(h);
+	for (int i=0; i<NUM_PROBES; i++, h += step)
+	{
+		uint64_t b = h % nbits;
+		if (0 == (bits[b / 64] & (1ULL << (b % 64)))) return false;
+	}
+	return true;
+}
+
+void LGDictFilter::Bloom::add(uint64_t h)
+{
+	uint64_t nbits = 64 * bits.size();
+	uint64_t step = step_hash(h);
+	for (int i=0; i<NUM_PROBES; i++, h += step)
+	{
+		uint64_t b = h % nbits;
+		bits[b / 64] |= (1ULL << (b % 64));
+	}
+}
+
+/// A Bloom miss is final only for words that no regex can match; see
+/// build().
+bool LGDictFilter::Bloom::can_reject(const std::string& word)
+{
+	if (0 == word.size()) return false;
+	for (char c : word)
+		if (c < 'a' or 'z' < c) return false;
+	return true;
+}
+
+// ------------------------------------------------------
+
+static bool file_exists(const std::string& path)
+{
+	return std::ifstream(path).good();
+}
+
+/// Find `file` in the dictionary directory for `lang`, looking in the
+/// same places, in the same order, as Link Grammar does. Returns the
+/// path, or the empty string if it is not found.
+static std::string find_dict_file(const std::string& lang,
+                                  const std::string& file)
+{
+	std::string name(lang + "/" + file);
+	if ('/' == lang[0])
+		return file_exists(name) ? name : "";
+
+	static const char* bases[] = {
+		".", "./data", "..", "../data",
+#ifdef LG_DICT_DATA_DIR
+		LG_DICT_DATA_DIR,
+#endif
+	};
+	for (const char* base : bases)
+	{
+		std::string path(std::string(base) + "/" + name);
+		if (file_exists(path)) return path;
+	}
+	return "";
+}
+
+/// True unless the regex can be shown never to match a word made of
+/// lowercase letters alone. It can, if it is anchored at the start of
+/// the word, and the first thing that it asks for, exactly once or
+/// more, is a character that is not a lowercase letter. Anything else
+/// is taken to match.
+static bool may_match_lower(const std::string& re)
+{
+	if (re.size() < 2 or '^' != re[0]) return true;
+	if (std::string::npos != re.find('|')) return true;
+
+	size_t i = 1;
+	unsigned char c = re[i];
+	if ('[' == c)
+	{
+		// A bracket expression; a ']' right after the '[' is a
+		// member, and not the end.
+		i++;
+		if (i < re.size() and '^' == re[i]) return true;
+		size_t start = i;
+		while (i < re.size() and (']' != re[i] or i == start))
+		{
+			unsigned char lo = re[i];
+			if ('\\' == lo) return true;
+			if ('[' == lo and i+1 < re.size())
+			{
+				if (':' != re[i+1]) return true;
+				size_t end = re.find(":]", i+2);
+				if (std::string::npos == end) return true;
+				std::string cls(re, i+2, end - i - 2);
+				if (cls != "digit" and cls != "upper" and cls != "punct" and
+				    cls != "space" and cls != "blank" and cls != "cntrl")
+					return true;
+				i = end + 2;
+				continue;
+			}
+			unsigned char hi = lo;
+			if (i+2 < re.size() and '-' == re[i+1] and ']' != re[i+2])
+			{
+				hi = re[i+2];
+				i += 2;
+			}
+			if (lo <= 'z' and 'a' <= hi) return true;
+			i++;
+		}
+		if (re.size() <= i) return true;
+		i++;
+	}
+	else if ('\\' == c)
+	{
+		// Escaped punctuation stands for itself; escaped letters
+		// and digits are classes, such as \w.
+		if (re.size() <= i+1 or isalnum((unsigned char) re[i+1]))
+			return true;
+		i += 2;
+	}
+	else
+	{
+		if (std::string(".()[]{}*+?$^").find(c) != std::string::npos)
+			return true;
+		if ('a' <= c and c <= 'z') return true;
+		i++;
+	}
+
+	// It must be there at least once.
+	if (i < re.size() and ('*' == re[i] or '?' == re[i] or '{' == re[i]))
+		return true;
+	return false;
+}
+
+/// Read a Link Grammar regex file. It holds lines such as
+///     NUMBERS: /^[0-9]+$/
+///     NOT-NUMBERS: !/^[0-9]+$/
+/// and comments, starting with '%'. Returns false if any regex might
+/// match a lowercase word, or if the file cannot be read. Negated
+/// regexes only narrow down what the others match, and are skipped.
+static bool no_lower_regexes(const std::string& path, std::string& why)
+{
+	std::ifstream in(path);
+	if (not in.good())
+	{
+		why = "cannot read " + path;
+		return false;
+	}
+	std::stringstream ss;
+	ss << in.rdbuf();
+	const std::string text(ss.str());
+
+	size_t i = 0;
+	while (i < text.size())
+	{
+		unsigned char c = text[i];
+		if (isspace(c)) { i++; continue; }
+		if ('%' == c)
+		{
+			i = text.find('\n', i);
+			if (std::string::npos == i) break;
+			continue;
+		}
+
+		size_t colon = text.find(':', i);
+		if (std::string::npos == colon)
+		{
+			why = "cannot make sense of " + path;
+			return false;
+		}
+		std::string name(text, i, colon - i);
+		i = colon + 1;
+		while (i < text.size() and isspace((unsigned char) text[i])) i++;
+
+		bool negated = (i < text.size() and '!' == text[i]);
+		if (negated) i++;
+		if (text.size() <= i or '/' != text[i])
+		{
+			why = "cannot make sense of " + path;
+			return false;
+		}
+
+		// The regex runs to the next slash that is not escaped.
+		std::string re;
+		for (i++; i < text.size() and '/' != text[i]; i++)
+		{
+			if ('\\' == text[i] and i+1 < text.size() and '/' == text[i+1])
+				i++;
+			re += text[i];
+		}
+		if (text.size() <= i)
+		{
+			why = "cannot make sense of " + path;
+			return false;
+		}
+		i++;
+
+		if (not negated and may_match_lower(re))
+		{
+			why = "the regex " + name + " might match lowercase words";
+			return false;
+		}
+	}
+	return true;
+}
+
+/// The filter is only for dictionaries whose whole word list is known
+/// up front, and whose regexes match no lowercase word.
+static bool filter_allowed(const LgDictionaryPtr& dict, std::string& why)
+{
+	const std::string& lang = dict->lang();
+	if (dict->atomspace() or 0 == lang.size())
+	{
+		why = "it is backed by an AtomSpace";
+		return false;
+	}
+
+	// Link Grammar looks for these first, and uses them if found.
+	if (0 < find_dict_file(lang, "storage.dict").size())
+	{
+		why = "it is backed by an AtomSpace";
+		return false;
+	}
+	if (0 < find_dict_file(lang, "dict.db").size())
+	{
+		why = "it is backed by a database";
+		return false;
+	}
+
+	std::string dpath(find_dict_file(lang, "4.0.dict"));
+	if (0 == dpath.size())
+	{
+		why = "its dictionary files cannot be found";
+		return false;
+	}
+
+	// The regex file is read from next to the dictionary file.
+	std::string rpath(dpath, 0, dpath.rfind('/'));
+	return no_lower_regexes(rpath + "/4.0.regex", why);
+}
+
+LGDictFilter::LGDictFilter(void) :
+	_enabled(false)
+{
+}
+
+/// Build a filter holding every word in the dictionary. Returns null
+/// if the filter is refused for it.
+std::shared_ptr<const LGDictFilter::Bloom>
+LGDictFilter::build(const LgDictionaryPtr& dict)
+{
+	std::string why;
+	if (not filter_allowed(dict, why))
+	{
+		logger().info("LGDictFilter: No word filter for \"%s\": %s",
+		              dict->lang().c_str(), why.c_str());
+		return nullptr;
+	}
+
+	std::vector<std::string> words(getDictWords(dict->get()));
+	if (0 == words.size()) return nullptr;
+
+	std::shared_ptr<Bloom> bloom(std::make_shared<Bloom>());
+	bloom->serial = dict->serial();
+	bloom->nwords = words.size();
+	bloom->bits.resize((BITS_PER_WORD * words.size() + 63) / 64);
+	for (const std::string& word : words)
+		bloom->add(word_hash(word));
+	bloom->known.assign(KNOWN_SLOTS, std::string());
+
+	return bloom;
+}
+
+bool LGDictFilter::enable(const LgDictionaryPtr& dict)
+{
+	// Build it outside of the lock; it takes a while.
+	std::shared_ptr<const Bloom> bloom(build(dict));
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	_enabled = (nullptr != bloom);
+	std::atomic_store(&_bloom, bloom);
+	return _enabled;
+}
+
+void LGDictFilter::disable(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_enabled = false;
+	std::atomic_store(&_bloom, std::shared_ptr<const Bloom>());
+}
+
+void LGDictFilter::rebuild(const LgDictionaryPtr& dict)
+{
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		if (not _enabled) return;
+	}
+
+	std::shared_ptr<const Bloom> bloom(build(dict));
+
+	// It may have been turned off in the meanwhile.
+	std::lock_guard<std::mutex> lck(_mtx);
+	if (_enabled) std::atomic_store(&_bloom, bloom);
+}
+
+/// Only the known-word cache takes a lock, and only for words that
+/// get past the Bloom filter; rejects take none.
+bool LGDictFilter::is_known(const LgDictionaryPtr& dict,
+                            const std::string& word)
+{
+	// No filter, or one for a different (older) copy of the dictionary.
+	std::shared_ptr<const Bloom> bloom(std::atomic_load(&_bloom));
+	if (nullptr == bloom or bloom->serial != dict->serial())
+		return haveDictEntry(dict->get(), word);
+
+	bloom->queries++;
+	uint64_t h = word_hash(word);
+	bool maybe = bloom->maybe(h);
+	if (not maybe and bloom->can_reject(word))
+	{
+		bloom->rejects++;
+		return false;
+	}
+
+	size_t slot = h % KNOWN_SLOTS;
+	{
+		std::lock_guard<std::mutex> lck(bloom->known_mtx);
+		if (bloom->known[slot] == word)
+		{
+			bloom->hits++;
+			return true;
+		}
+	}
+
+	bloom->lookups++;
+	bool have = haveDictEntry(dict->get(), word);
+	if (have)
+	{
+		std::lock_guard<std::mutex> lck(bloom->known_mtx);
+		bloom->known[slot] = word;
+	}
+	else if (maybe)
+		bloom->false_positives++;
+	return have;
+}
+
+LGDictFilter::Stats LGDictFilter::get_stats(void)
+{
+	Stats st;
+	std::shared_ptr<const Bloom> bloom(std::atomic_load(&_bloom));
+	if (nullptr == bloom) return st;
+
+	st.queries = bloom->queries;
+	st.rejects = bloom->rejects;
+	st.hits = bloom->hits;
+	st.lookups = bloom->lookups;
+	st.false_positives = bloom->false_positives;
+	st.words = bloom->nwords;
+	st.bytes = sizeof(uint64_t) * bloom->bits.size();
+	return st;
+}
+
+/* ===================== END OF FILE ===================== */
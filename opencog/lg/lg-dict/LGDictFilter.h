@@ -0,0 +1,131 @@
+/*
+ * LGDictFilter.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LG_DICT_FILTER_H
+#define _OPENCOG_LG_DICT_FILTER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <opencog/lg/lg-dict/LGDictRegistry.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// Fast "is this word in the dictionary?" check, one per LgDictNode.
+///
+/// LgHaveDictEntry is often used to weed out candidate words, inside
+/// of queries, where most of the candidates are not words at all. Each
+/// check is a dictionary lookup. When this filter is turned on, a
+/// Bloom filter, built from the word list of the dictionary, answers
+/// most of the misses, without going to Link Grammar. Words that get
+/// past it are looked up as before; the ones that are found are kept
+/// in a small cache of known words, so that common words are not
+/// looked up over and over.
+///
+/// The filter is off by default. It is built for one copy of the
+/// dictionary, and used only with that one; it is rebuilt when the
+/// dictionary is reloaded.
+///
+/// The filter only ever gives definite answers. Link Grammar also
+/// knows words that are not in the word list, through its regexes,
+/// and those cannot be told apart by the word list alone. So the
+/// filter is built only for dictionaries that are read from files,
+/// whose regex file shows that no regex can match a word made of
+/// lowercase letters; a Bloom miss is final only for such words.
+/// It is refused for all others: those backed by an AtomSpace or a
+/// database, whose word lists hold only what has been loaded so far,
+/// and those with regexes that might match lowercase words (such as
+/// "en", which guesses at words by their endings).
+class LGDictFilter
+{
+public:
+	struct Stats
+	{
+		size_t queries = 0;
+		size_t rejects = 0;          // Answered by the Bloom filter.
+		size_t hits = 0;             // Answered by the known-word cache.
+		size_t lookups = 0;          // Passed on to Link Grammar.
+		size_t false_positives = 0;  // ... passed the Bloom filter, but
+		                             //     not found there.
+		size_t words = 0;
+		size_t bytes = 0;
+	};
+
+private:
+	// The bits are immutable, once built. The known words and the
+	// counts start over with each new filter.
+	struct Bloom
+	{
+		size_t serial;
+		std::vector<uint64_t> bits;
+		size_t nwords;
+
+		mutable std::mutex known_mtx;
+		mutable std::vector<std::string> known;
+
+		mutable std::atomic<size_t> queries{0};
+		mutable std::atomic<size_t> rejects{0};
+		mutable std::atomic<size_t> hits{0};
+		mutable std::atomic<size_t> lookups{0};
+		mutable std::atomic<size_t> false_positives{0};
+
+		bool maybe(uint64_t) const;
+		void add(uint64_t);
+		static bool can_reject(const std::string&);
+	};
+
+	// Guards turning the filter on and off; queries don't take it.
+	std::mutex _mtx;
+	bool _enabled;
+
+	// Read and written with std::atomic_load/atomic_store.
+	std::shared_ptr<const Bloom> _bloom;
+
+	static std::shared_ptr<const Bloom> build(const LgDictionaryPtr&);
+
+public:
+	LGDictFilter(void);
+
+	// Turn the filter on, building it for the dictionary. Returns
+	// false if the filter is refused for it; the filter stays off.
+	bool enable(const LgDictionaryPtr&);
+	void disable(void);
+
+	// If the filter is on, build it again, for a reloaded dictionary.
+	void rebuild(const LgDictionaryPtr&);
+
+	// True if the dictionary has the word.
+	bool is_known(const LgDictionaryPtr&, const std::string&);
+
+	Stats get_stats(void);
+};
+
+/** @}*/
+}
+#endif // _OPENCOG_LG_DICT_FILTER_H
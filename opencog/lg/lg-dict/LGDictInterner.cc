@@ -0,0 +1,76 @@
+/*
+ * LGDictInterner.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/base/Node.h>
+#include <opencog/lg/types/atom_types.h>
+#include "LGDictInterner.h"
+
+using namespace opencog;
+
+LGDictInterner::LGDictInterner(void)
+{
+	_minus = createNode(LG_CONN_DIR_NODE, "-");
+	_plus = createNode(LG_CONN_DIR_NODE, "+");
+}
+
+Handle LGDictInterner::connector(const std::string& name, char dir,
+                                 bool multi)
+{
+	std::string key;
+	key.reserve(name.size() + 2);
+	if (multi) key += '@';
+	key += name;
+	key += dir;
+
+	auto it = _connectors.find(key);
+	if (_connectors.end() != it) return it->second;
+
+	static Handle hmulti(createNode(LG_CONN_MULTI_NODE, "@"));
+
+	Handle hname(createNode(LG_CONN_NODE, std::string(name)));
+	Handle hdir;
+	if ('-' == dir) hdir = _minus;
+	else if ('+' == dir) hdir = _plus;
+	else hdir = createNode(LG_CONN_DIR_NODE, std::string(1, dir));
+
+	Handle conn;
+	if (multi)
+		conn = createLink(LG_CONNECTOR, hname, hdir, hmulti);
+	else
+		conn = createLink(LG_CONNECTOR, hname, hdir);
+
+	_connectors.emplace(std::move(key), conn);
+	return conn;
+}
+
+/// The outgoing set must hold interned Atoms only.
+Handle LGDictInterner::conseq(HandleSeq&& oset)
+{
+	auto it = _seqs.find(oset);
+	if (_seqs.end() != it) return it->second;
+
+	Handle seq(createLink(HandleSeq(oset), CONNECTOR_SEQ));
+	_seqs.emplace(std::move(oset), seq);
+	return seq;
+}
+
+/* ===================== END OF FILE ===================== */
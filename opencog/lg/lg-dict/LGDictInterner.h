@@ -0,0 +1,83 @@
+/*
+ * LGDictInterner.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LG_DICT_INTERNER_H
+#define _OPENCOG_LG_DICT_INTERNER_H
+
+#include <string>
+#include <unordered_map>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// Lookup-scoped hash-consing table for the Atoms of a dictionary
+/// entry.
+///
+/// After DNF expansion, the same few connectors appear over and over,
+/// in disjunct after disjunct, and the same disjunct can come out of
+/// several branches of the expression. Each distinct LgConnector, and
+/// each distinct ConnectorSeq, is built once, and handed out again
+/// after that. Because the connectors are unique, two ConnectorSeqs
+/// with the same content have the very same outgoing Handles; they
+/// are keyed on those, without looking inside them.
+///
+/// Not thread-safe; use one per lookup.
+class LGDictInterner
+{
+	struct SeqHash
+	{
+		size_t operator()(const HandleSeq& seq) const
+		{
+			size_t hash = seq.size();
+			for (const Handle& h : seq)
+				hash = hash * 31 + std::hash<const Atom*>()(h.get());
+			return hash;
+		}
+	};
+
+	// LgConnectors, keyed by the connector string, e.g. "@Ss+".
+	std::unordered_map<std::string, Handle> _connectors;
+
+	// ConnectorSeqs, keyed by their outgoing set.
+	std::unordered_map<HandleSeq, Handle, SeqHash> _seqs;
+
+	Handle _minus;
+	Handle _plus;
+
+public:
+	LGDictInterner(void);
+
+	Handle connector(const std::string&, char, bool);
+	Handle conseq(HandleSeq&&);
+
+	// Number of distinct Atoms built.
+	size_t size(void) const { return _connectors.size() + _seqs.size(); }
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_LG_DICT_INTERNER_H
@@ -20,6 +20,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <chrono>
 #include <mutex>
 
 #include <link-grammar/link-includes.h>
@@ -54,59 +55,228 @@ void error_handler(lg_errinfo *ei, void *data)
 // ------------------------------------------------------
 
 LgDictNode::LgDictNode(const std::string&& name)
-	: Node(LG_DICT_NODE, std::move(name)), _dict(nullptr)
+	: Node(LG_DICT_NODE, std::move(name)),
+	_reloading(false), _reload_count(0), _reload_secs(0.0)
 {
 }
 
 LgDictNode::~LgDictNode()
 {
-	if (_dict)
-		dictionary_delete(_dict);
-
-	_dict = nullptr;
+	for (Parse_Options opts : _opts_pool)
+		parse_options_delete(opts);
 }
 
-// Link grammar dictionary creation is NOT thread-safe.
-static std::mutex _global_mtx;
-
 /// Get the dictionary associated with the node.  This performs a
 /// delayed open, because we don't really want the open to happen
 /// in the constructor (since the constructor might run multiple
-/// times!?)
-Dictionary LgDictNode::get_dictionary()
+/// times!?) The dictionary itself comes from the process-wide
+/// registry, and is shared with all other LgDictNodes of the same
+/// name, in all AtomSpaces.
+LgDictionaryPtr LgDictNode::get_dictionary()
+{
+	LgDictSlotPtr slot(std::atomic_load(&_slot));
+	if (nullptr == slot)
+	{
+		std::lock_guard<std::mutex> lck(_dict_mtx);
+
+		// Check again, this time under the lock.
+		slot = std::atomic_load(&_slot);
+		if (nullptr == slot)
+		{
+			slot = lg_dict_registry().get_slot(get_name(),
+			                      Handle::UNDEFINED, Handle::UNDEFINED);
+			std::atomic_store(&_slot, slot);
+		}
+	}
+
+	LgDictionaryPtr ldp(slot->get());
+	if (ldp) return ldp;
+
+	lg_error_set_handler(error_handler, nullptr);
+	return lg_dict_registry().get(slot);
+}
+
+/// Get the dictionary for the given AtomSpace and StorageNode; either
+/// may be null. Each configuration gets its own dictionary; see
+/// LGDictRegistry.
+LgDictionaryPtr LgDictNode::get_dictionary(const Handle& asp,
+                                           const Handle& stnp)
+{
+	if (nullptr == asp and nullptr == stnp)
+		return get_dictionary();
+
+	LgDictSlotPtr slot;
+	{
+		std::pair<Handle, Handle> cfg(asp, stnp);
+		std::lock_guard<std::mutex> lck(_dict_mtx);
+		auto it = _config_slots.find(cfg);
+		if (_config_slots.end() != it)
+			slot = it->second;
+		else
+		{
+			slot = lg_dict_registry().get_slot(get_name(), asp, stnp);
+			_config_slots.emplace(cfg, slot);
+		}
+	}
+
+	LgDictionaryPtr ldp(slot->get());
+	if (ldp) return ldp;
+
+	lg_error_set_handler(error_handler, nullptr);
+	return lg_dict_registry().get(slot);
+}
+
+// ------------------------------------------------------
+
+/// Start a reload, on the registry's reload thread. The queued reload
+/// holds a reference to this Node, so that the Node cannot go away
+/// before the reload has run.
+bool LgDictNode::reload()
 {
-	if (_dict) return _dict;
+	if (_reloading.exchange(true)) return false;
+
+	LgDictNodePtr self(LgDictNodeCast(get_handle()));
+	lg_dict_registry().run_reload([self]() { self->do_reload(); });
+	return true;
+}
 
+/// Open fresh copies of the dictionaries that this Node has open, and
+/// put them in the registry slots, for this and all other Nodes of the
+/// same name. The copies are opened without holding any lock, so that
+/// parses can carry on with the old ones in the meanwhile. Old copies
+/// that are still being used stay open until their last parse finishes.
+void LgDictNode::do_reload()
+{
 	lg_error_set_handler(error_handler, nullptr);
-	const char * lang = get_name().c_str();
+	auto start = std::chrono::steady_clock::now();
+
+	std::vector<LgDictSlotPtr> slots;
+	{
+		std::lock_guard<std::mutex> lck(_dict_mtx);
+		for (const auto& pr : _config_slots)
+			slots.push_back(pr.second);
+	}
 
-	// Link grammar dictionary creation is NOT thread-safe.
-	std::lock_guard<std::mutex> lck(_global_mtx);
+	// The default dictionary is always reloaded, even if it was never
+	// opened, or was evicted.
+	LgDictSlotPtr slot(std::atomic_load(&_slot));
+	if (nullptr == slot)
+		slot = lg_dict_registry().get_slot(get_name(),
+		                      Handle::UNDEFINED, Handle::UNDEFINED);
 
-	// Check again, this time under the lock.
-	if (_dict) return _dict;
+	LgDictionaryPtr fresh(lg_dict_registry().reopen(slot));
+	if (nullptr == fresh)
+		logger().warn("LgDictNode: Unable to reload dictionary \"%s\"",
+		              get_name().c_str());
 
-	_dict = dictionary_create_lang(lang);
-	return _dict;
+	for (const LgDictSlotPtr& cslot : slots)
+		lg_dict_registry().reopen(cslot);
+
+	double secs = std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - start).count();
+	{
+		std::lock_guard<std::mutex> lck(_dict_mtx);
+		if (nullptr == std::atomic_load(&_slot))
+			std::atomic_store(&_slot, slot);
+		_reload_count++;
+		_reload_secs = secs;
+	}
+	_entry_cache.clear();
+
+	// Until it is rebuilt, the word filter steps aside.
+	if (fresh) _word_filter.rebuild(fresh);
+	_reloading = false;
+}
+
+size_t LgDictNode::reload_count()
+{
+	std::lock_guard<std::mutex> lck(_dict_mtx);
+	return _reload_count;
+}
+
+double LgDictNode::reload_seconds()
+{
+	std::lock_guard<std::mutex> lck(_dict_mtx);
+	return _reload_secs;
+}
+
+// ------------------------------------------------------
+
+/// Get a set of parse options from the pool, creating a new set if
+/// the pool is empty. The options come back with the settings that
+/// all Atomese parses use: no messages, and non-repeatable random
+/// sampling of linkages. The resource (timer) limits are reset, and
+/// null counts are set to zero. Everything else (parse time, linkage
+/// limit) is up to the caller.
+Parse_Options LgDictNode::checkout_parse_options(void)
+{
+	Parse_Options opts = nullptr;
+	{
+		std::lock_guard<std::mutex> lck(_opts_mtx);
+		if (0 < _opts_pool.size())
+		{
+			opts = _opts_pool.back();
+			_opts_pool.pop_back();
+		}
+	}
+
+	if (nullptr == opts)
+	{
+		opts = parse_options_create();
+
+		// Set to 0 to disable all messages (including warnings).
+		// Set to 1 to get basic info and warnings.
+		// Set to 2 to get timing info.
+		// Set to 6 to get pruning/power-pruning info.
+		// We want 0 here, because otherwise the log fills up with
+		// [WARN] Combinatorial explosion! messages. Yuck.
+		parse_options_set_verbosity(opts, 0);
+
+		// For the ANY language, this code is being used for sampling.
+		// In this case, we are not concerned about reproducibility,
+		// but want different, truly random results each time through.
+		// Viz, every time we have a four-word sentence, we want a
+		// different parse for it, each time. Bug #3065.
+		parse_options_set_repeatable_rand(opts, 0);
+	}
+
+	// Undo whatever the last user did.
+	parse_options_reset_resources(opts);
+	parse_options_set_min_null_count(opts, 0);
+	parse_options_set_max_null_count(opts, 0);
+
+	return opts;
+}
+
+/// Put the parse options back in the pool.
+void LgDictNode::return_parse_options(Parse_Options opts)
+{
+	std::lock_guard<std::mutex> lck(_opts_mtx);
+	_opts_pool.push_back(opts);
 }
 
 // ------------------------------------------------------
 
 // This is called, when the atom is both inserted, and deleted from
 // the AtomSpace. It's harmless on insertion. On deletion, it will
-// close and blow away the dictionary, freeing any malloc'ed cruft.
-// The core issue is that the deletion in the dtor is not enough:
-// guile might be holding on to pointers, that prevent the dtor from
-// running.
+// let go of the dictionary, so that it can be closed, freeing any
+// malloc'ed cruft. The core issue is that the deletion in the dtor
+// is not enough: guile might be holding on to pointers, that prevent
+// the dtor from running.
 void LgDictNode::setAtomSpace(AtomSpace* as)
 {
 	Node::setAtomSpace(as);
 
-	// Zap the dict.
-	std::lock_guard<std::mutex> lck(_global_mtx);
-	if (nullptr == _dict) return;
-	dictionary_delete(_dict);
-	_dict = nullptr;
+	// Moving between AtomSpaces is harmless; keep the dicts.
+	if (as) return;
+
+	// Let go of the dicts. They are closed if no other LgDictNode
+	// is using them.
+	std::lock_guard<std::mutex> lck(_dict_mtx);
+	_config_slots.clear();
+	std::atomic_store(&_slot, LgDictSlotPtr());
+	_entry_cache.clear();
+	_word_filter.disable();
 }
 
 // ------------------------------------------------------
@@ -23,9 +23,16 @@
 #ifndef _OPENCOG_LG_DICT_NODE_H
 #define _OPENCOG_LG_DICT_NODE_H
 
+#include <atomic>
+#include <map>
+#include <mutex>
 #include <string>
+#include <vector>
 #include <link-grammar/dict-api.h>
 #include <opencog/atoms/base/Node.h>
+#include <opencog/lg/lg-dict/LGDictEntryCache.h>
+#include <opencog/lg/lg-dict/LGDictFilter.h>
+#include <opencog/lg/lg-dict/LGDictRegistry.h>
 
 namespace opencog
 {
@@ -38,11 +45,58 @@ namespace opencog
 /// external data source that certain subsystems need to access to
 /// obtain grammatical data.  The Node holds a pointer to the Link
 /// Grammar Dictionary itself, so that it can be directly accessed.
+///
+/// The dictionaries themselves come from the LGDictRegistry, and are
+/// shared by all LgDictNodes having the same name, in all AtomSpaces.
+/// The Node holds the registry slot for each dictionary, and not the
+/// dictionary itself, so that evicting or reloading it in the registry
+/// affects all of these Nodes at once.
+///
+/// Dictionaries that are backed by an AtomSpace can be opened with
+/// different AtomSpace/StorageNode pairs. The Node keeps one open
+/// Dictionary per pair, so that parses using different pairs can run
+/// at the same time, without clobbering one another's configuration.
+/// A Dictionary can be shared by any number of concurrent parses.
+///
+/// The dictionaries can be reloaded, while in use. The fresh copies
+/// are opened on a background thread; once they are ready, they are
+/// swapped in, and new parses use them from then on. Parses that are
+/// already running hold a reference to the old copy, and keep using
+/// it; the old copy is closed when the last of them finishes.
+///
+/// The Node caches the entries looked up in its default dictionary;
+/// see LGDictEntryCache. The cache is emptied on reload. It can also
+/// keep a filter of the words in that dictionary; see LGDictFilter.
+/// The filter is rebuilt on reload.
+///
+/// The Node also keeps a pool of Parse_Options, so that parsers using
+/// this dictionary do not have to create and destroy a fresh set for
+/// every sentence. Each parse checks one out, and hands it back when
+/// done; no two threads ever share a Parse_Options.
 
 class LgDictNode : public Node
 {
 protected:
-	Dictionary _dict;
+	std::mutex _dict_mtx;
+
+	// The slot for the default configuration: no AtomSpace.
+	LgDictSlotPtr _slot;
+
+	// Slots for other AtomSpace/StorageNode configurations.
+	std::map<std::pair<Handle, Handle>, LgDictSlotPtr> _config_slots;
+
+	std::mutex _opts_mtx;
+	std::vector<Parse_Options> _opts_pool;
+
+	LGDictEntryCache _entry_cache;
+	LGDictFilter _word_filter;
+
+	// Reload status.
+	std::atomic<bool> _reloading;
+	size_t _reload_count;
+	double _reload_secs;
+
+	void do_reload(void);
 
 public:
 	LgDictNode(const std::string&&);
@@ -51,7 +105,26 @@ public:
 	virtual ~LgDictNode();
 	virtual void setAtomSpace(AtomSpace*);
 
-	Dictionary get_dictionary(void);
+	// Parses must hold on to the returned pointer for as long as they
+	// use the dictionary.
+	LgDictionaryPtr get_dictionary(void);
+	LgDictionaryPtr get_dictionary(const Handle&, const Handle&);
+
+	// Reopen all dictionaries in use, in the background. Returns false
+	// if a reload is already under way.
+	bool reload(void);
+
+	// Number of reloads completed, and how long (in seconds) the most
+	// recent one took.
+	bool reloading(void) const { return _reloading; }
+	size_t reload_count(void);
+	double reload_seconds(void);
+
+	LGDictEntryCache& entry_cache(void) { return _entry_cache; }
+	LGDictFilter& word_filter(void) { return _word_filter; }
+
+	Parse_Options checkout_parse_options(void);
+	void return_parse_options(Parse_Options);
 
 	static Handle factory(const Handle&);
 };
@@ -23,6 +23,12 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <link-grammar/link-includes.h>
+
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/base/Node.h>
 #include <opencog/lg/types/atom_types.h>
@@ -30,40 +36,9 @@
 
 using namespace opencog;
 
-/**
- * Helper function for storing LG expression trees in custom container.
- *
- * @param exp   the input expression trees
- * @return      the flatten container
- */
-static LGDictExpContainer lg_exp_to_container(const Exp* exp)
-{
-    if (CONNECTOR_type == exp->type)
-        return LGDictExpContainer(CONNECTOR_type, exp);
-
-    std::vector<LGDictExpContainer> subcontainers;
-
-    // FIXME XXX -- Optionals are handled incorrectly here;
-    // they are denoted by a null Exp pointer in an OR_list!
-    // Ignoring all the nulls is just ... wrong.
-#if (LINK_MAJOR_VERSION == 5) &&  (LINK_MINOR_VERSION < 7)
-    E_list* el = exp->u.l;
-    while (el)
-    {
-        subcontainers.push_back(lg_exp_to_container(el->e));
-        el = el->next;
-    }
-#else
-    const Exp* subexp = lg_exp_operand_first((Exp*) exp);
-    while (subexp)
-    {
-        subcontainers.push_back(lg_exp_to_container(subexp));
-        subexp = lg_exp_operand_next((Exp*) subexp);
-    }
-#endif
-
-    return LGDictExpContainer(exp->type, subcontainers);
-}
+// Link Grammar keeps the subscript of a dictionary word after this
+// mark, e.g. "test\3n" for "test.n".
+#define SUBSCRIPT_MARK '\3'
 
 /**
  * Function to return LG dictionary entries.
@@ -108,10 +83,12 @@ HandleSeq opencog::getDictEntry(Dictionary _dictionary,
 
     Handle hWord(createNode(WORD_NODE, std::move(std::string(word))));
 
+    // The entries of a word share most of their connectors.
+    LGDictInterner intern;
     for (Dict_node* dn = dn_head; dn; dn = dn->right)
     {
         Exp* exp = dn->exp;
-        HandleSeq qLG = lg_exp_to_container(exp).to_handle(hWord);
+        HandleSeq qLG = LGDictExpContainer(exp).to_handle(hWord, intern);
 
         outgoing.insert(outgoing.end(), qLG.begin(), qLG.end());
     }
@@ -126,3 +103,22 @@ bool opencog::haveDictEntry(Dictionary _dictionary,
 	// See if we know about this word, or not.
 	return dictionary_word_is_known(_dictionary, word.c_str());
 }
+
+std::vector<std::string> opencog::getDictWords(Dictionary _dictionary)
+{
+    std::vector<std::string> words;
+    Dict_node* dn_head = dictionary_lookup_wild(_dictionary, "*");
+    for (Dict_node* dn = dn_head; dn; dn = dn->right)
+    {
+        const char* str = dn->string;
+        const char* sub = strchr(str, SUBSCRIPT_MARK);
+        if (sub) words.emplace_back(str, sub - str);
+        else words.emplace_back(str);
+    }
+    free_lookup_list(_dictionary, dn_head);
+
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+    return words;
+}
+
@@ -24,6 +24,9 @@
 #ifndef _OPENCOG_LG_DICT_READER_H
 #define _OPENCOG_LG_DICT_READER_H
 
+#include <string>
+#include <vector>
+
 #include <link-grammar/dict-api.h>
 #include "LGDictExpContainer.h"
 
@@ -44,6 +47,16 @@ HandleSeq getDictEntry(Dictionary, const std::string& word);
  */
 bool haveDictEntry(Dictionary, const std::string& word);
 
+/**
+ * Link Grammar dictionary word list.
+ *
+ * Return every word in the dictionary, without subscripts, each once,
+ * in sorted order.  Words that are matched only by regexes are not in
+ * it.  For dictionaries that are backed by an AtomSpace, only the words
+ * that have been loaded so far are in it.
+ */
+std::vector<std::string> getDictWords(Dictionary);
+
 }
 
 #endif // _OPENCOG_LG_DICT_READER_H
@@ -0,0 +1,374 @@
+/*
+ * LGDictRegistry.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstdlib>
+
+#include <link-grammar/link-includes.h>
+#if LINK_MAJOR_VERSION == 5 && LINK_MINOR_VERSION >= 11
+#include <link-grammar/dict-atomese.h>
+#endif
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/persist/api/StorageNode.h>
+
+#include "LGDictRegistry.h"
+
+using namespace opencog;
+
+std::mutex& opencog::lg_dict_global_mutex()
+{
+	static std::mutex mtx;
+	return mtx;
+}
+
+// Defined in LGDictNode.cc
+void error_handler(lg_errinfo *ei, void *data);
+
+static std::atomic<size_t> num_dicts_open(0);
+static std::atomic<size_t> next_serial(1);
+
+LgDictionary::LgDictionary(Dictionary d, const std::string& lang,
+                           bool atomspace) :
+	_dict(d), _serial(next_serial++), _lang(lang), _atomspace(atomspace)
+{
+	num_dicts_open++;
+}
+
+LgDictionary::~LgDictionary()
+{
+	{
+		std::lock_guard<std::mutex> lck(lg_dict_global_mutex());
+		dictionary_delete(_dict);
+	}
+	num_dicts_open--;
+}
+
+size_t LgDictionary::num_open()
+{
+	return num_dicts_open;
+}
+
+/// AtomSpace-backed dictionaries are configured through process-wide
+/// state in Link Grammar, read when the dictionary is created. So the
+/// configuration and the creation happen together, under the lock;
+/// after that, each dictionary keeps its own.
+Dictionary LGDictRegistry::open(const std::string& lang,
+                                const Handle& asp, const Handle& stnp)
+{
+	std::lock_guard<std::mutex> glck(lg_dict_global_mutex());
+#if LINK_MAJOR_VERSION == 5 && LINK_MINOR_VERSION >= 11
+	lg_config_atomspace(AtomSpaceCast(asp), StorageNodeCast(stnp));
+#endif
+	Dictionary dict = dictionary_create_lang(lang.c_str());
+#if LINK_MAJOR_VERSION == 5 && LINK_MINOR_VERSION >= 11
+	lg_config_atomspace(nullptr, nullptr);
+#endif
+	return dict;
+}
+
+LgDictSlotPtr LGDictRegistry::get_slot(const std::string& lang,
+                                       const Handle& asp, const Handle& stnp)
+{
+	Key key(lang, asp, stnp);
+	std::lock_guard<std::mutex> lck(_mtx);
+
+	auto it = _slots.find(key);
+	if (_slots.end() != it)
+	{
+		LgDictSlotPtr slot(it->second.lock());
+		if (slot) return slot;
+		_slots.erase(it);
+	}
+
+	LgDictSlotPtr slot(std::make_shared<LgDictSlot>(lang, asp, stnp));
+	_slots.emplace(key, slot);
+	return slot;
+}
+
+/// Opening takes the slot's own lock, so that two LgDictNodes asking
+/// for the same dictionary at the same time do not both open it. The
+/// registry lock is not held; lookups of other slots, and of slots
+/// that are open already, go ahead while a large dictionary loads.
+LgDictionaryPtr LGDictRegistry::get(const LgDictSlotPtr& slot)
+{
+	LgDictionaryPtr ldp(slot->get());
+	if (ldp) return ldp;
+
+	std::lock_guard<std::mutex> lck(slot->_open_mtx);
+	ldp = slot->get();
+	if (ldp) return ldp;
+
+	// Don't remember failures; the dictionary may yet get fixed up.
+	Dictionary dict = open(slot->_lang, slot->_asp, slot->_stnp);
+	if (nullptr == dict) return nullptr;
+
+	ldp = std::make_shared<LgDictionary>(dict, slot->_lang,
+		nullptr != slot->_asp or nullptr != slot->_stnp);
+	std::atomic_store(&slot->_dict, ldp);
+	return ldp;
+}
+
+/// The new copy is opened without holding the registry lock, so that
+/// requests for dictionaries that are already open are not held up
+/// while it loads. The old copy is let go out here, too.
+LgDictionaryPtr LGDictRegistry::reopen(const LgDictSlotPtr& slot)
+{
+	Dictionary dict = open(slot->_lang, slot->_asp, slot->_stnp);
+	if (nullptr == dict) return nullptr;
+
+	LgDictionaryPtr ldp(std::make_shared<LgDictionary>(dict, slot->_lang,
+		nullptr != slot->_asp or nullptr != slot->_stnp));
+	LgDictionaryPtr old(std::atomic_exchange(&slot->_dict, ldp));
+	return ldp;
+}
+
+size_t LGDictRegistry::evict(const std::string& lang)
+{
+	// Unpin it first. Whatever closes, closes out here, and not under
+	// either lock below.
+	LgDictSlotPtr pinned;
+	{
+		std::lock_guard<std::mutex> lck(_pre_mtx);
+		auto pit = _pinned.find(lang);
+		if (_pinned.end() != pit)
+		{
+			pinned = pit->second;
+			_pinned.erase(pit);
+			_pre_state.erase(lang);
+		}
+	}
+
+	std::vector<LgDictionaryPtr> evicted;
+	std::lock_guard<std::mutex> lck(_mtx);
+	for (auto it = _slots.begin(); it != _slots.end(); )
+	{
+		LgDictSlotPtr slot(it->second.lock());
+		if (nullptr == slot)
+		{
+			it = _slots.erase(it);
+			continue;
+		}
+		if (std::get<0>(it->first) == lang)
+		{
+			LgDictionaryPtr ldp(std::atomic_exchange(&slot->_dict,
+			                                         LgDictionaryPtr()));
+			if (ldp) evicted.emplace_back(ldp);
+		}
+		it++;
+	}
+	return evicted.size();
+}
+
+size_t LGDictRegistry::size()
+{
+	return LgDictionary::num_open();
+}
+
+LGDictRegistry::LGDictRegistry() :
+	_pre_running(false), _reload_running(false)
+{
+	// Dictionaries pinned here are closed under the global mutex, when
+	// the registry is destroyed. So the mutex must outlive us; statics
+	// are destroyed in the reverse order of their construction.
+	lg_dict_global_mutex();
+}
+
+LGDictRegistry::~LGDictRegistry()
+{
+	{
+		std::lock_guard<std::mutex> lck(_pre_mtx);
+		_pre_queue.clear();
+	}
+	if (_pre_thread.joinable())
+		_pre_thread.join();
+
+	// Whatever the dropped reloads hold on to is let go out here.
+	std::deque<std::function<void()>> dropped;
+	{
+		std::lock_guard<std::mutex> lck(_reload_mtx);
+		dropped.swap(_reload_queue);
+	}
+	if (_reload_thread.joinable())
+		_reload_thread.join();
+}
+
+void LGDictRegistry::declare_preload(const std::string& lang)
+{
+	std::lock_guard<std::mutex> lck(_pre_mtx);
+	_declared.push_back(lang);
+}
+
+void LGDictRegistry::start_preload()
+{
+	std::vector<std::string> langs;
+	{
+		std::lock_guard<std::mutex> lck(_pre_mtx);
+		langs.swap(_declared);
+	}
+
+	const char* env = getenv("LG_ATOMESE_PRELOAD");
+	if (env)
+	{
+		std::string lang;
+		for (const char* p = env; ; p++)
+		{
+			if (0 == *p or ' ' == *p or ',' == *p)
+			{
+				if (0 < lang.size()) langs.push_back(lang);
+				lang.clear();
+				if (0 == *p) break;
+			}
+			else
+				lang += *p;
+		}
+	}
+
+	for (const std::string& lang : langs)
+		preload(lang);
+}
+
+void LGDictRegistry::preload(const std::string& lang)
+{
+	std::lock_guard<std::mutex> lck(_pre_mtx);
+
+	// Already done, or in progress.
+	auto it = _pre_state.find(lang);
+	if (_pre_state.end() != it and PRELOAD_FAILED != it->second)
+		return;
+
+	_pre_state[lang] = PRELOAD_PENDING;
+	_pre_queue.push_back(lang);
+	if (_pre_running) return;
+
+	// The previous loader, if any, is done; start another.
+	if (_pre_thread.joinable()) _pre_thread.join();
+	_pre_running = true;
+	_pre_thread = std::thread(&LGDictRegistry::preload_loop, this);
+}
+
+/// Open dictionaries, one after another, until there are no more.
+void LGDictRegistry::preload_loop()
+{
+	lg_error_set_handler(error_handler, nullptr);
+
+	while (true)
+	{
+		std::string lang;
+		{
+			std::lock_guard<std::mutex> lck(_pre_mtx);
+			if (_pre_queue.empty())
+			{
+				_pre_running = false;
+				return;
+			}
+			lang = _pre_queue.front();
+			_pre_queue.pop_front();
+		}
+
+		LgDictSlotPtr slot(get_slot(lang, Handle::UNDEFINED, Handle::UNDEFINED));
+		LgDictionaryPtr ldp(get(slot));
+		if (ldp) warm_up(ldp->get());
+
+		std::lock_guard<std::mutex> lck(_pre_mtx);
+		_pre_state[lang] = ldp ? PRELOAD_READY : PRELOAD_FAILED;
+		if (ldp) _pinned[lang] = slot;
+	}
+}
+
+/// Parse a few sentences, so that the parts of the dictionary that
+/// nearly every sentence needs are paged in, before the first real
+/// request arrives.
+void LGDictRegistry::warm_up(Dictionary dict)
+{
+	static const char* sentences[] = {
+		"This is a test.",
+		"The quick brown fox jumped over the lazy dog.",
+		"I saw the man with the telescope, and he saw me.",
+	};
+
+	Parse_Options opts = parse_options_create();
+	parse_options_set_verbosity(opts, 0);
+	parse_options_set_max_parse_time(opts, 5);
+	parse_options_set_linkage_limit(opts, 10);
+
+	for (const char* str : sentences)
+	{
+		Sentence sent = sentence_create(str, dict);
+		if (nullptr == sent) continue;
+		sentence_parse(sent, opts);
+		sentence_delete(sent);
+	}
+	parse_options_delete(opts);
+	lg_error_flush();
+	lg_error_clearall();
+}
+
+bool LGDictRegistry::ready(const std::string& lang)
+{
+	std::lock_guard<std::mutex> lck(_pre_mtx);
+	if (0 == lang.size())
+		return _pre_queue.empty() and not _pre_running;
+
+	auto it = _pre_state.find(lang);
+	return _pre_state.end() != it and PRELOAD_READY == it->second;
+}
+
+void LGDictRegistry::run_reload(std::function<void()> fn)
+{
+	std::lock_guard<std::mutex> lck(_reload_mtx);
+	_reload_queue.push_back(std::move(fn));
+	if (_reload_running) return;
+
+	// The previous reloader, if any, is done; start another.
+	if (_reload_thread.joinable()) _reload_thread.join();
+	_reload_running = true;
+	_reload_thread = std::thread(&LGDictRegistry::reload_loop, this);
+}
+
+/// Run reloads, one after another, until there are no more.
+void LGDictRegistry::reload_loop()
+{
+	lg_error_set_handler(error_handler, nullptr);
+
+	while (true)
+	{
+		std::function<void()> fn;
+		{
+			std::lock_guard<std::mutex> lck(_reload_mtx);
+			if (_reload_queue.empty())
+			{
+				_reload_running = false;
+				return;
+			}
+			fn = std::move(_reload_queue.front());
+			_reload_queue.pop_front();
+		}
+		fn();
+	}
+}
+
+LGDictRegistry& opencog::lg_dict_registry()
+{
+	static LGDictRegistry registry;
+	return registry;
+}
+
+/* ===================== END OF FILE ===================== */
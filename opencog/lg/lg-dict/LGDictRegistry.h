@@ -0,0 +1,212 @@
+/*
+ * LGDictRegistry.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LG_DICT_REGISTRY_H
+#define _OPENCOG_LG_DICT_REGISTRY_H
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <link-grammar/dict-api.h>
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// An open Link Grammar Dictionary. It is closed when the last
+/// reference to it is dropped.
+class LgDictionary
+{
+	Dictionary _dict;
+	size_t _serial;
+	std::string _lang;
+	bool _atomspace;
+
+public:
+	LgDictionary(Dictionary d, const std::string& lang, bool atomspace);
+	LgDictionary(const LgDictionary&) = delete;
+	LgDictionary& operator=(const LgDictionary&) = delete;
+	~LgDictionary();
+
+	Dictionary get() const { return _dict; }
+
+	// The language (or dictionary path) that it was opened with.
+	const std::string& lang() const { return _lang; }
+
+	// True if it was opened with an AtomSpace or StorageNode to draw
+	// on. Such dictionaries may get their words from there, a few at
+	// a time.
+	bool atomspace() const { return _atomspace; }
+
+	// Never the same for two LgDictionaries, even if one is opened
+	// after the other is closed, at the same address. Things that
+	// are good only for one copy of a dictionary are tagged with it.
+	size_t serial() const { return _serial; }
+
+	// Number of LgDictionaries that are open right now.
+	static size_t num_open();
+};
+
+typedef std::shared_ptr<LgDictionary> LgDictionaryPtr;
+
+/// The dictionary for one language and AtomSpace/StorageNode
+/// configuration, shared by all of the LgDictNodes that use it.
+/// LgDictNodes hold on to the slot, and not to the dictionary; the
+/// registry can empty the slot (evict) or put a fresh copy into it
+/// (reload), and every LgDictNode sees the change the next time that
+/// it looks. Parses hold on to the dictionary that they started with.
+class LgDictSlot
+{
+	friend class LGDictRegistry;
+
+	std::string _lang;
+	Handle _asp;
+	Handle _stnp;
+
+	// Read and written with std::atomic_load/atomic_store.
+	LgDictionaryPtr _dict;
+
+	// Held while the dictionary is being opened, so that it is opened
+	// only once, without holding up requests for other slots.
+	std::mutex _open_mtx;
+
+public:
+	LgDictSlot(const std::string& lang, const Handle& asp,
+	           const Handle& stnp) :
+		_lang(lang), _asp(asp), _stnp(stnp) {}
+
+	// The dictionary in the slot; null if it has not been opened yet,
+	// or has been evicted.
+	LgDictionaryPtr get() const { return std::atomic_load(&_dict); }
+};
+
+typedef std::shared_ptr<LgDictSlot> LgDictSlotPtr;
+
+/// Process-wide registry of open dictionaries.
+///
+/// Opening a dictionary takes seconds, for the larger languages.
+/// All LgDictNodes, in all AtomSpaces, get their dictionaries from
+/// here, so that a language, with a given AtomSpace/StorageNode
+/// configuration, is opened only once. The registry does not itself
+/// keep dictionaries open: a dictionary is closed as soon as the last
+/// LgDictNode using it lets go. A dictionary can also be evicted; it
+/// is closed once the parses using it are done, and the next request
+/// for it opens a fresh copy.
+class LGDictRegistry
+{
+	typedef std::tuple<std::string, Handle, Handle> Key;
+
+	// Guards the map only; never held while a dictionary is opened.
+	std::mutex _mtx;
+	std::map<Key, std::weak_ptr<LgDictSlot>> _slots;
+
+	// Preloading. Preloaded dictionaries are pinned: they stay open,
+	// even with no users, until evicted.
+	enum PreloadState { PRELOAD_PENDING, PRELOAD_READY, PRELOAD_FAILED };
+	std::mutex _pre_mtx;
+	std::vector<std::string> _declared;
+	std::deque<std::string> _pre_queue;
+	std::map<std::string, PreloadState> _pre_state;
+	std::map<std::string, LgDictSlotPtr> _pinned;
+	std::thread _pre_thread;
+	bool _pre_running;
+
+	// Reloads run one after another, on a thread of their own; opening
+	// is serialized by Link Grammar anyway.
+	std::mutex _reload_mtx;
+	std::deque<std::function<void()>> _reload_queue;
+	std::thread _reload_thread;
+	bool _reload_running;
+
+	void preload_loop();
+	void reload_loop();
+	static void warm_up(Dictionary);
+	static Dictionary open(const std::string&, const Handle&, const Handle&);
+
+public:
+	LGDictRegistry();
+	~LGDictRegistry();
+
+	// Get the slot for a language and an (optional) AtomSpace and
+	// StorageNode. Nothing is opened.
+	LgDictSlotPtr get_slot(const std::string&, const Handle&, const Handle&);
+
+	// Get the dictionary in the slot, opening it if needed. Returns
+	// null if it cannot be opened.
+	LgDictionaryPtr get(const LgDictSlotPtr&);
+
+	// Open a fresh copy of the dictionary, whether or not one is open
+	// already, and put it in the slot. Those holding the old one keep
+	// it, until they let go. Returns null (and changes nothing) if it
+	// cannot be opened.
+	LgDictionaryPtr reopen(const LgDictSlotPtr&);
+
+	// Empty the slots for a language, in all configurations. The
+	// dictionaries are closed once the parses using them are done.
+	// Returns the number of dictionaries let go.
+	size_t evict(const std::string&);
+
+	// Run a reload in the background, on the registry's reload thread.
+	// Reloads still queued when the registry is destroyed are dropped.
+	void run_reload(std::function<void()>);
+
+	// Number of dictionaries that are open.
+	size_t size();
+
+	// Ask for a dictionary to be opened when the module is loaded.
+	// Languages listed in the LG_ATOMESE_PRELOAD environment variable
+	// (separated by spaces or commas) are declared automatically.
+	void declare_preload(const std::string&);
+
+	// Start opening all declared dictionaries, in the background.
+	// Called from opencog_lg_init().
+	void start_preload();
+
+	// Open a dictionary in the background, right away. Once open, a
+	// few sentences are parsed with it, to fault in its pages.
+	void preload(const std::string&);
+
+	// True if the named dictionary has been preloaded and warmed up.
+	// For the empty string, true if no preloads are pending.
+	bool ready(const std::string&);
+};
+
+LGDictRegistry& lg_dict_registry();
+
+// Link Grammar dictionary creation and deletion are NOT thread-safe.
+// Hold this lock while doing either.
+std::mutex& lg_dict_global_mutex();
+
+/** @}*/
+}
+
+#endif // _OPENCOG_LG_DICT_REGISTRY_H
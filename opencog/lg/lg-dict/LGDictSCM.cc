@@ -22,9 +22,13 @@
  */
 
 #include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/value/FloatValue.h>
 #include <opencog/guile/SchemePrimitive.h>
+#include <opencog/util/exceptions.h>
 
+#include "LGDictNode.h"
 #include "LGDictReader.h"
+#include "LGDictRegistry.h"
 #include "LGDictUtils.h"
 
 namespace opencog
@@ -38,6 +42,16 @@ private:
 
     bool do_lg_conn_type_match(Handle, Handle);
     bool do_lg_conn_linkable(Handle, Handle);
+    int do_lg_dict_evict(const std::string&);
+    int do_lg_dict_open_count(void);
+    void do_lg_dict_preload(const std::string&);
+    bool do_lg_dict_ready(const std::string&);
+    bool do_lg_dict_reload(Handle);
+    ValuePtr do_lg_dict_reload_stats(Handle);
+    void do_lg_dict_cache_config(Handle, int, double);
+    ValuePtr do_lg_dict_cache_stats(Handle);
+    bool do_lg_dict_filter_config(Handle, bool);
+    ValuePtr do_lg_dict_filter_stats(Handle);
 
 public:
     LGDictSCM();
@@ -93,6 +107,26 @@ void LGDictSCM::init()
 		 &LGDictSCM::do_lg_conn_type_match, this, "lg");
 	define_scheme_primitive("lg-conn-linkable?",
 		 &LGDictSCM::do_lg_conn_linkable, this, "lg");
+	define_scheme_primitive("lg-dict-evict",
+		 &LGDictSCM::do_lg_dict_evict, this, "lg");
+	define_scheme_primitive("lg-dict-open-count",
+		 &LGDictSCM::do_lg_dict_open_count, this, "lg");
+	define_scheme_primitive("lg-dict-preload",
+		 &LGDictSCM::do_lg_dict_preload, this, "lg");
+	define_scheme_primitive("lg-dict-ready?",
+		 &LGDictSCM::do_lg_dict_ready, this, "lg");
+	define_scheme_primitive("lg-dict-reload",
+		 &LGDictSCM::do_lg_dict_reload, this, "lg");
+	define_scheme_primitive("lg-dict-reload-stats",
+		 &LGDictSCM::do_lg_dict_reload_stats, this, "lg");
+	define_scheme_primitive("lg-dict-cache-config",
+		 &LGDictSCM::do_lg_dict_cache_config, this, "lg");
+	define_scheme_primitive("lg-dict-cache-stats",
+		 &LGDictSCM::do_lg_dict_cache_stats, this, "lg");
+	define_scheme_primitive("lg-dict-filter-config",
+		 &LGDictSCM::do_lg_dict_filter_config, this, "lg");
+	define_scheme_primitive("lg-dict-filter-stats",
+		 &LGDictSCM::do_lg_dict_filter_stats, this, "lg");
 }
 
 /**
@@ -119,6 +153,155 @@ bool LGDictSCM::do_lg_conn_linkable(Handle h1, Handle h2)
 	return lg_conn_linkable(h1, h2);
 }
 
+/**
+ * Implementation of the "lg-dict-evict" scheme primitive.
+ *
+ * @param lang  the dictionary name, e.g. "en"
+ * @return      the number of open dictionaries evicted
+ */
+int LGDictSCM::do_lg_dict_evict(const std::string& lang)
+{
+	return lg_dict_registry().evict(lang);
+}
+
+/**
+ * Implementation of the "lg-dict-open-count" scheme primitive.
+ *
+ * @return      the number of open dictionaries
+ */
+int LGDictSCM::do_lg_dict_open_count(void)
+{
+	return lg_dict_registry().size();
+}
+
+/**
+ * Implementation of the "lg-dict-preload" scheme primitive.
+ *
+ * @param lang  the dictionary name, e.g. "en"
+ */
+void LGDictSCM::do_lg_dict_preload(const std::string& lang)
+{
+	lg_dict_registry().preload(lang);
+}
+
+/**
+ * Implementation of the "lg-dict-ready?" scheme primitive.
+ *
+ * @param lang  the dictionary name, or the empty string for all
+ * @return      true if preloaded and warmed up
+ */
+bool LGDictSCM::do_lg_dict_ready(const std::string& lang)
+{
+	return lg_dict_registry().ready(lang);
+}
+
+static LgDictNodePtr get_dict_node(const Handle& h)
+{
+	LgDictNodePtr ldn(LgDictNodeCast(h));
+	if (nullptr == ldn)
+		throw InvalidParamException(TRACE_INFO,
+			"Expecting an LgDictNode, got %s", h->to_string().c_str());
+	return ldn;
+}
+
+/**
+ * Implementation of the "lg-dict-reload" scheme primitive.
+ *
+ * @param h     the LgDictNode
+ * @return      false if a reload is already under way
+ */
+bool LGDictSCM::do_lg_dict_reload(Handle h)
+{
+	return get_dict_node(h)->reload();
+}
+
+/**
+ * Implementation of the "lg-dict-reload-stats" scheme primitive.
+ *
+ * @param h     the LgDictNode
+ * @return      FloatValue holding reloads done, seconds taken by the
+ *              last one, and 1 if a reload is under way, else 0.
+ */
+ValuePtr LGDictSCM::do_lg_dict_reload_stats(Handle h)
+{
+	LgDictNodePtr ldn(get_dict_node(h));
+	bool busy = ldn->reloading();
+	return createFloatValue(std::vector<double>({
+		(double) ldn->reload_count(), ldn->reload_seconds(),
+		busy ? 1.0 : 0.0}));
+}
+
+/**
+ * Implementation of the "lg-dict-cache-config" scheme primitive.
+ *
+ * @param h          the LgDictNode
+ * @param entries    maximum number of cached words; zero disables.
+ * @param megabytes  maximum estimated memory use; zero for no limit.
+ */
+void LGDictSCM::do_lg_dict_cache_config(Handle h, int entries,
+                                        double megabytes)
+{
+	if (entries < 0) entries = 0;
+	if (megabytes < 0.0) megabytes = 0.0;
+	get_dict_node(h)->entry_cache().set_limits(entries,
+		megabytes * 1024.0 * 1024.0);
+}
+
+/**
+ * Implementation of the "lg-dict-cache-stats" scheme primitive.
+ *
+ * @param h     the LgDictNode
+ * @return      FloatValue holding hits, misses, evictions, entries, bytes.
+ */
+ValuePtr LGDictSCM::do_lg_dict_cache_stats(Handle h)
+{
+	LGDictEntryCache::Stats st =
+		get_dict_node(h)->entry_cache().get_stats();
+	return createFloatValue(std::vector<double>({
+		(double) st.hits, (double) st.misses, (double) st.evictions,
+		(double) st.entries, (double) st.bytes}));
+}
+
+/**
+ * Implementation of the "lg-dict-filter-config" scheme primitive.
+ *
+ * @param h     the LgDictNode
+ * @param on    turn the word filter on or off
+ * @return      true if the filter is on
+ */
+bool LGDictSCM::do_lg_dict_filter_config(Handle h, bool on)
+{
+	LgDictNodePtr ldn(get_dict_node(h));
+	if (not on)
+	{
+		ldn->word_filter().disable();
+		return false;
+	}
+
+	LgDictionaryPtr dict = ldn->get_dictionary();
+	if (nullptr == dict)
+		throw InvalidParamException(TRACE_INFO,
+			"Unable to open dictionary %s", ldn->get_name().c_str());
+	return ldn->word_filter().enable(dict);
+}
+
+/**
+ * Implementation of the "lg-dict-filter-stats" scheme primitive.
+ *
+ * @param h     the LgDictNode
+ * @return      FloatValue holding queries, rejects, hits, lookups,
+ *              false positives, words, bytes.
+ */
+ValuePtr LGDictSCM::do_lg_dict_filter_stats(Handle h)
+{
+	LGDictFilter::Stats st =
+		get_dict_node(h)->word_filter().get_stats();
+	return createFloatValue(std::vector<double>({
+		(double) st.queries, (double) st.rejects, (double) st.hits,
+		(double) st.lookups, (double) st.false_positives,
+		(double) st.words, (double) st.bytes}));
+}
+
 // Global initialization via constructor
 static __attribute__ ((constructor)) void init(void)
 {
@@ -0,0 +1,172 @@
+/*
+ * LGDictStream.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/core/NumberNode.h>
+#include "LGDictNode.h"
+#include "LGDictStream.h"
+
+using namespace opencog;
+
+/// The expected format of an LgDictStream is:
+///
+///     LgDictStream
+///         WordNode "antidisestablishmentarianism"
+///         LgDictNode "en"
+///         NumberNode 10         -- optional; max number of disjuncts
+///         NumberNode 1.5        -- optional; max disjunct cost
+///         NumberNode 4          -- optional; disjuncts per chunk
+///
+/// When executed, the word is looked up in the indicated dictionary,
+/// but its disjuncts are not expanded; that happens as they are asked
+/// for, through the returned LgDisjunctStream.
+///
+void LGDictStream::init()
+{
+	const HandleSeq& oset = _outgoing;
+
+	size_t osz = oset.size();
+	if (2 > osz or 5 < osz)
+		throw InvalidParamException(TRACE_INFO,
+			"LgDictStream: Expecting two to five arguments, got %lu", osz);
+
+	Type pht = oset[0]->get_type();
+	if (WORD_NODE != pht and VARIABLE_NODE != pht and GLOB_NODE != pht)
+		throw InvalidParamException(TRACE_INFO,
+			"LgDictStream: Expecting WordNode, got %s",
+			oset[0]->to_string().c_str());
+
+	Type dit = oset[1]->get_type();
+	if (LG_DICT_NODE != dit and VARIABLE_NODE != dit and GLOB_NODE != dit)
+		throw InvalidParamException(TRACE_INFO,
+			"LgDictStream: Expecting LgDictNode, got %s",
+			oset[1]->to_string().c_str());
+
+	for (size_t i=2; i<osz; i++)
+	{
+		Type nit = oset[i]->get_type();
+		if (NUMBER_NODE != nit and VARIABLE_NODE != nit and GLOB_NODE != nit)
+			throw InvalidParamException(TRACE_INFO,
+				"LgDictStream: Expecting NumberNode, got %s",
+				oset[i]->to_string().c_str());
+	}
+}
+
+LGDictStream::LGDictStream(const HandleSeq&& oset, Type t)
+	: FunctionLink(std::move(oset), t)
+{
+	// Type must be as expected
+	if (not nameserver().isA(t, LG_DICT_STREAM))
+	{
+		const std::string& tname = nameserver().getTypeName(t);
+		throw InvalidParamException(TRACE_INFO,
+			"Expecting an LgDictStream, got %s", tname.c_str());
+	}
+	init();
+}
+
+// =================================================================
+
+/// The optional number at position i, or the default.
+double LGDictStream::get_number(size_t i, double dflt) const
+{
+	if (_outgoing.size() <= i) return dflt;
+
+	if (NUMBER_NODE != _outgoing[i]->get_type())
+		throw InvalidParamException(TRACE_INFO,
+			"LgDictStream: Invalid outgoing set at %lu; expecting NumberNode",
+			i);
+	return NumberNodeCast(_outgoing[i])->get_value();
+}
+
+ValuePtr LGDictStream::execute(AtomSpace* as, bool silent)
+{
+	if (WORD_NODE != _outgoing[0]->get_type())
+	{
+		if (silent) throw SilentException();
+		throw InvalidParamException(TRACE_INFO,
+			"LgDictStream: Expecting WordNode, got %s",
+			_outgoing[0]->to_string().c_str());
+	}
+
+	if (LG_DICT_NODE != _outgoing[1]->get_type())
+	{
+		if (silent) throw SilentException();
+		throw InvalidParamException(TRACE_INFO,
+			"LgDictStream: Expecting LgDictNode, got %s",
+			_outgoing[1]->to_string().c_str());
+	}
+
+	double cap = get_number(2, 0.0);
+	double max_cost = get_number(3, -1.0);
+	double chunk = get_number(4, 1.0);
+
+	// Get the dictionary
+	LgDictNodePtr ldn(LgDictNodeCast(_outgoing[1]));
+	LgDictionaryPtr dict = ldn->get_dictionary();
+	if (nullptr == dict)
+		throw InvalidParamException(TRACE_INFO,
+			"LgDictStream requires valid dictionary! %s was given.",
+			ldn->get_name().c_str());
+
+	// The enumerator takes what it needs from the dictionary right
+	// away; the stream does not hold on to the dictionary.
+	std::unique_ptr<LGDisjunctEnumerator> enumr(
+		new LGDisjunctEnumerator(dict->get(), _outgoing[0]->get_name(),
+		                         max_cost, (0.0 < cap) ? (size_t) cap : 0));
+
+	return createLGDisjunctStream(std::move(enumr),
+		AtomSpaceCast(as->get_handle()),
+		(1.0 < chunk) ? (size_t) chunk : 1);
+}
+
+DEFINE_LINK_FACTORY(LGDictStream, LG_DICT_STREAM)
+
+// =================================================================
+
+LGDisjunctStream::LGDisjunctStream(
+                             std::unique_ptr<LGDisjunctEnumerator>&& enumr,
+                             const AtomSpacePtr& asp, size_t chunk) :
+	LinkValue(LG_DISJUNCT_STREAM), _enum(std::move(enumr)),
+	_asp(asp), _chunk(chunk)
+{
+}
+
+/// Hand out the next chunk. Once there are no more, let go of the
+/// enumerator, and stay empty.
+void LGDisjunctStream::update() const
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_value.clear();
+	if (nullptr == _enum) return;
+
+	HandleSeq djs(_enum->next(_chunk));
+	if (0 == djs.size())
+	{
+		_enum.reset();
+		return;
+	}
+
+	for (const Handle& dj : djs)
+		_value.emplace_back(_asp->add_atom(dj));
+}
+
+/* ===================== END OF FILE ===================== */
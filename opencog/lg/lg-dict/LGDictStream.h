@@ -0,0 +1,101 @@
+/*
+ * LGDictStream.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LG_DICT_STREAM_H
+#define _OPENCOG_LG_DICT_STREAM_H
+
+#include <memory>
+#include <mutex>
+
+#include <opencog/atoms/core/FunctionLink.h>
+#include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/lg/lg-dict/LGDisjunctEnumerator.h>
+#include <opencog/lg/types/atom_types.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// Streaming Link Grammar dictionary lookup.
+///
+/// Like LgDictEntry, but the disjuncts are handed out a few at a
+/// time, as they are asked for, instead of all at once. The expected
+/// format is:
+///
+///     LgDictStream
+///         WordNode "foobar"
+///         LgDictNode "en"
+///         NumberNode 10         -- optional; stop after this many
+///         NumberNode 1.5        -- optional; max disjunct cost
+///         NumberNode 4          -- optional; disjuncts per chunk
+///
+/// Executing it returns an LgDisjunctStream. A cap of zero, or a
+/// negative cost, means no limit. The default chunk size is one.
+
+class LGDictStream : public FunctionLink
+{
+protected:
+	void init();
+	double get_number(size_t, double) const;
+
+public:
+	LGDictStream(const HandleSeq&&, Type=LG_DICT_STREAM);
+	LGDictStream(const LGDictStream&) = delete;
+	LGDictStream& operator=(const LGDictStream&) = delete;
+
+	// Return the stream of disjuncts.
+	virtual ValuePtr execute(AtomSpace*, bool);
+
+	static Handle factory(const Handle&);
+};
+
+LINK_PTR_DECL(LGDictStream)
+#define createLGDictStream CREATE_DECL(LGDictStream)
+
+/// The disjuncts of a word, one chunk at a time. Each time that it is
+/// looked at, it holds the next chunk of disjuncts, which are also
+/// added to the AtomSpace. Once all of them have been handed out, it
+/// is empty.
+class LGDisjunctStream : public LinkValue
+{
+protected:
+	mutable std::mutex _mtx;
+	mutable std::unique_ptr<LGDisjunctEnumerator> _enum;
+	AtomSpacePtr _asp;
+	size_t _chunk;
+
+	virtual void update() const;
+
+public:
+	LGDisjunctStream(std::unique_ptr<LGDisjunctEnumerator>&&,
+	                 const AtomSpacePtr&, size_t);
+	virtual ~LGDisjunctStream() {}
+};
+
+VALUE_PTR_DECL(LGDisjunctStream);
+CREATE_VALUE_DECL(LGDisjunctStream);
+
+/** @}*/
+}
+#endif // _OPENCOG_LG_DICT_STREAM_H
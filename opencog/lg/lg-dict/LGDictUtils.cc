@@ -26,6 +26,7 @@
 #include <opencog/atoms/base/Node.h>
 #include <opencog/lg/types/atom_types.h>
 
+#include "LGConnNode.h"
 #include "LGDictUtils.h"
 
 using namespace opencog;
@@ -46,6 +47,11 @@ Handle lg_conn_get_dir(const Handle& hConn)
 
 /**
  * Check if two connectors' type matches.
+ *
+ * The names are matched by lg_conn_desc_match(), using the LgConnDesc
+ * that each LgConnNode works out when it is created. Connector names
+ * that are not (yet) in an AtomSpace are plain Nodes; their LgConnDesc
+ * is worked out here, on the stack. Either way, nothing is allocated.
 
 XXX FIXME -- this currently fails to correctly handle the head-tail
 indicators on link types.  Perhaps it would be better to just call
@@ -61,41 +67,23 @@ bool lg_conn_type_match(const Handle& hConn1, const Handle& hConn2)
         hConn2->get_type() != LG_CONNECTOR)
         return false;
 
-    // Convert the types to string
-    std::string type1 = lg_conn_get_type(hConn1)->get_name();
-    std::string type2 = lg_conn_get_type(hConn2)->get_name();
-    uint i1 = 0;
-    uint i2 = 0;
-
-    // check header
-    if (islower((int) type1[i1]))
-        i1++;
-    if (islower((int) type2[i2]))
-        i2++;
-
-    if (i1 > 0 && i2 > 0 && type1[0] == type2[0])
-        return false;
+    const Handle& hType1 = hConn1->getOutgoingSet()[0];
+    const Handle& hType2 = hConn2->getOutgoingSet()[0];
 
-    while (i1 < type1.length() and i2 < type2.length())
-    {
-        if (isupper((int) type1[i1]) or isupper((int) type2[i2]))
-        {
-            if (type1[i1] != type2[i2])
-                return false;
+    const LgConnNode* cn1 = dynamic_cast<const LgConnNode*>(hType1.get());
+    const LgConnNode* cn2 = dynamic_cast<const LgConnNode*>(hType2.get());
 
-            i1++;
-            i2++;
-            continue;
-        }
+    LgConnDesc tmp1, tmp2;
+    if (nullptr == cn1) tmp1 = LgConnDesc(hType1->get_name());
+    if (nullptr == cn2) tmp2 = LgConnDesc(hType2->get_name());
 
-        if (type1[i1] != '*' and type2[i2] != '*' and type1[i1] != type2[i2])
-            return false;
+    const LgConnDesc& d1 = cn1 ? cn1->get_desc() : tmp1;
+    const LgConnDesc& d2 = cn2 ? cn2->get_desc() : tmp2;
 
-        i1++;
-        i2++;
-    }
+    if (d1.is_long() or d2.is_long())
+        return lg_conn_name_match(hType1->get_name(), hType2->get_name());
 
-    return true;
+    return lg_conn_desc_match(d1, d2);
 }
 
 /**
@@ -0,0 +1,317 @@
+/*
+ * LGDisjunctEnumerator.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <limits>
+
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/base/Node.h>
+#include <opencog/lg/types/atom_types.h>
+#include "LGDisjunctEnumerator.h"
+
+using namespace opencog;
+
+// Costs are sums of small decimal fractions; allow for round-off.
+#define COST_EPSILON 1.0e-6
+
+static double exp_cost(const Exp* exp)
+{
+#if (LINK_MAJOR_VERSION == 5) && (LINK_MINOR_VERSION >= 9)
+	return lg_exp_get_cost(exp);
+#else
+	return 0.0;
+#endif
+}
+
+LGDisjunctEnumerator::LGDisjunctEnumerator(Dictionary dict,
+                                           const std::string& word,
+                                           double max_cost, size_t cap) :
+	_root(0), _positioned(false),
+	_max_cost(max_cost < 0.0 ?
+		std::numeric_limits<double>::infinity() : max_cost),
+	_cap(cap), _count(0)
+{
+	Dict_node* dn_head = dictionary_lookup_list(dict, word.c_str());
+	if (nullptr == dn_head) return;
+
+	for (Dict_node* dn = dn_head; dn; dn = dn->right)
+		_roots.push_back(build(dn->exp));
+
+	free_lookup_list(dict, dn_head);
+}
+
+/// Copy the expression tree, bottom-up, noting the cheapest way
+/// through each subtree.
+LGDisjunctEnumerator::Index LGDisjunctEnumerator::build(const Exp* exp)
+{
+	static Handle multi(createNode(LG_CONN_MULTI_NODE, "@"));
+
+	Node n;
+	n.type = exp->type;
+	n.cost = exp_cost(exp);
+	n.dir = '+';
+	n.choice = 0;
+
+	if (CONNECTOR_type == exp->type)
+	{
+#if (LINK_MAJOR_VERSION == 5) && (LINK_MINOR_VERSION < 5)
+		std::string str(exp->u.string);
+		n.dir = exp->dir;
+		bool is_multi = exp->multi;
+#else
+		std::string str(lg_exp_get_string(exp));
+		n.dir = lg_exp_get_dir(exp);
+		bool is_multi = lg_exp_get_multi(exp);
+#endif
+		Handle connector(createNode(LG_CONN_NODE, std::move(str)));
+		Handle direction(createNode(LG_CONN_DIR_NODE, std::string(1, n.dir)));
+		if (is_multi)
+			n.conn = createLink(LG_CONNECTOR, connector, direction, multi);
+		else
+			n.conn = createLink(LG_CONNECTOR, connector, direction);
+		n.mincost = n.cost;
+		n.nterms = 1;
+	}
+	else
+	{
+#if (LINK_MAJOR_VERSION == 5) && (LINK_MINOR_VERSION < 7)
+		for (E_list* el = exp->u.l; el; el = el->next)
+			n.subs.push_back(build(el->e));
+#else
+		const Exp* subexp = lg_exp_operand_first((Exp*) exp);
+		while (subexp)
+		{
+			n.subs.push_back(build(subexp));
+			subexp = lg_exp_operand_next((Exp*) subexp);
+		}
+#endif
+
+		// An OR with nothing in it has no way through.
+		double sub = (AND_type == n.type) ? 0.0 :
+			std::numeric_limits<double>::infinity();
+		unsigned int nterms = (AND_type == n.type) ? 1 : 0;
+		for (Index i : n.subs)
+		{
+			const Node& ch = _nodes[i];
+			if (AND_type == n.type)
+			{
+				sub += ch.mincost;
+				nterms = std::min(2U, nterms * ch.nterms);
+			}
+			else
+			{
+				sub = std::min(sub, ch.mincost);
+				nterms = std::min(2U, nterms + ch.nterms);
+			}
+		}
+		n.mincost = n.cost + sub;
+		n.nterms = nterms;
+	}
+
+	_nodes.emplace_back(std::move(n));
+	return _nodes.size() - 1;
+}
+
+/// Position the subtree at its first disjunct costing no more than
+/// the budget. Returns false if there is none.
+bool LGDisjunctEnumerator::reset(Index i, double budget)
+{
+	Node& n = _nodes[i];
+	if (budget + COST_EPSILON < n.mincost) return false;
+	n.budget = budget - n.cost;
+
+	if (CONNECTOR_type == n.type)
+	{
+		n.spent = n.cost;
+		return true;
+	}
+
+	if (OR_type == n.type)
+	{
+		for (n.choice = 0; n.choice < n.subs.size(); n.choice++)
+		{
+			if (reset(n.subs[n.choice], n.budget))
+			{
+				n.spent = n.cost + _nodes[n.subs[n.choice]].spent;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	return fill(i, 0);
+}
+
+/// AND nodes: the children before k are positioned; position the
+/// rest, backtracking into the earlier ones as needed. Each child
+/// gets whatever the others leave over: the budget, less what the
+/// earlier ones spent, less the least that the later ones can cost.
+bool LGDisjunctEnumerator::fill(Index i, size_t k)
+{
+	Node& n = _nodes[i];
+	size_t nsub = n.subs.size();
+	while (k < nsub)
+	{
+		double avail = n.budget;
+		for (size_t j = 0; j < k; j++) avail -= _nodes[n.subs[j]].spent;
+		for (size_t j = k+1; j < nsub; j++) avail -= _nodes[n.subs[j]].mincost;
+
+		if (reset(n.subs[k], avail))
+		{
+			k++;
+			continue;
+		}
+
+		// Nothing fits; try the next choice for an earlier child.
+		while (true)
+		{
+			if (0 == k) return false;
+			k--;
+			if (advance(n.subs[k])) { k++; break; }
+		}
+	}
+
+	n.spent = n.cost;
+	for (Index sub : n.subs) n.spent += _nodes[sub].spent;
+	return true;
+}
+
+/// Move the subtree on to its next disjunct, within the budget that
+/// it was last reset with. Returns false if there are no more.
+bool LGDisjunctEnumerator::advance(Index i)
+{
+	Node& n = _nodes[i];
+	if (CONNECTOR_type == n.type) return false;
+
+	if (OR_type == n.type)
+	{
+		if (n.choice < n.subs.size() and advance(n.subs[n.choice]))
+		{
+			n.spent = n.cost + _nodes[n.subs[n.choice]].spent;
+			return true;
+		}
+		for (n.choice++; n.choice < n.subs.size(); n.choice++)
+		{
+			if (reset(n.subs[n.choice], n.budget))
+			{
+				n.spent = n.cost + _nodes[n.subs[n.choice]].spent;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// AND: odometer; the last child turns fastest.
+	size_t k = n.subs.size();
+	while (0 < k)
+	{
+		k--;
+		if (advance(n.subs[k])) return fill(i, k+1);
+	}
+	return false;
+}
+
+/// True if LGDictExpContainer turns the subtree into an OR, when it
+/// expands it to DNF.
+bool LGDisjunctEnumerator::or_like(Index i) const
+{
+	const Node& n = _nodes[i];
+	return CONNECTOR_type != n.type and 1 != n.nterms;
+}
+
+/// Gather the connectors of the current disjunct, the ones pointing
+/// left apart from the ones pointing right.
+///
+/// The order is the one that getDictEntry() gives. When it expands an
+/// AND to DNF, it moves the parts coming from ORs after the rest, in
+/// the order of the ORs. The same is done here.
+void LGDisjunctEnumerator::collect(Index i, HandleSeq& left,
+                                   HandleSeq& right) const
+{
+	const Node& n = _nodes[i];
+	if (CONNECTOR_type == n.type)
+	{
+		if ('-' == n.dir) left.push_back(n.conn);
+		else right.push_back(n.conn);
+		return;
+	}
+
+	if (OR_type == n.type)
+	{
+		collect(n.subs[n.choice], left, right);
+		return;
+	}
+
+	for (Index sub : n.subs)
+		if (not or_like(sub)) collect(sub, left, right);
+	for (Index sub : n.subs)
+		if (or_like(sub)) collect(sub, left, right);
+}
+
+/// Move on to the next disjunct, from whichever dictionary entry has
+/// one. Returns false when all of them are used up.
+bool LGDisjunctEnumerator::step(void)
+{
+	if (_positioned and advance(_roots[_root])) return true;
+	if (_positioned) _root++;
+	_positioned = false;
+
+	for (; _root < _roots.size(); _root++)
+	{
+		if (reset(_roots[_root], _max_cost))
+		{
+			_positioned = true;
+			return true;
+		}
+	}
+	return false;
+}
+
+/// The disjuncts have the same form as those from getDictEntry(): a
+/// ConnectorSeq, with the left-pointing connectors first, or, if there
+/// is only one connector, that connector alone.
+HandleSeq LGDisjunctEnumerator::next(size_t n)
+{
+	HandleSeq djs;
+	while (djs.size() < n)
+	{
+		if (0 < _cap and _cap <= _count) break;
+		if (not step()) break;
+
+		HandleSeq conns, right;
+		collect(_roots[_root], conns, right);
+		conns.insert(conns.end(), right.begin(), right.end());
+
+		Handle dj;
+		if (1 == conns.size())
+			dj = conns[0];
+		else
+			dj = createLink(std::move(conns), CONNECTOR_SEQ);
+
+		// The same disjunct can be reached in more than one way.
+		if (not _seen.insert(dj).second) continue;
+
+		_count++;
+		djs.emplace_back(dj);
+	}
+	return djs;
+}
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,122 @@
+/*
+ * LGDisjunctEnumerator.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LG_DISJUNCT_ENUMERATOR_H
+#define _OPENCOG_LG_DISJUNCT_ENUMERATOR_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <link-grammar/dict-api.h>
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// Enumerate the disjuncts of a word, a few at a time.
+///
+/// The dictionary entries of some words expand to tens of thousands
+/// of disjuncts. Rather than expanding all of them up front, as
+/// getDictEntry() does, this walks the expression tree, producing the
+/// disjuncts one at a time, in the same form that getDictEntry()
+/// gives them. Each distinct disjunct is produced once.
+///
+/// A cost threshold prunes every part of the tree that costs more;
+/// such parts are never visited. With a threshold of zero, only the
+/// cheapest disjuncts of the usual dictionaries are produced. A cap
+/// stops the enumeration after that many disjuncts.
+///
+/// The expression tree is copied when the enumerator is created, so
+/// that the dictionary is not needed after that. Not thread-safe.
+class LGDisjunctEnumerator
+{
+	typedef uint32_t Index;
+
+	struct Node
+	{
+		Exp_type type;
+		double cost;     // Cost of this node alone.
+		double mincost;  // Cheapest way through this subtree.
+		Handle conn;     // CONNECTOR_type only.
+		char dir;
+		std::vector<Index> subs;
+
+		// Number of disjuncts, counting repeats: 0, 1 or 2 for many.
+		uint8_t nterms;
+
+		// Iteration state.
+		double budget;   // What is left for the children.
+		size_t choice;   // OR_type: the child being iterated.
+		double spent;    // Cost of the current disjunct.
+	};
+
+	std::vector<Node> _nodes;
+	std::vector<Index> _roots;   // One per dictionary entry.
+	size_t _root;
+	bool _positioned;
+
+	double _max_cost;
+	size_t _cap;
+	size_t _count;
+
+	struct ContentHash
+	{
+		size_t operator()(const Handle& h) const { return h->get_hash(); }
+	};
+	struct ContentEq
+	{
+		bool operator()(const Handle& a, const Handle& b) const
+		{ return *a == *b; }
+	};
+	std::unordered_set<Handle, ContentHash, ContentEq> _seen;
+
+	Index build(const Exp*);
+	bool reset(Index, double);
+	bool advance(Index);
+	bool fill(Index, size_t);
+	bool or_like(Index) const;
+	void collect(Index, HandleSeq&, HandleSeq&) const;
+	bool step(void);
+
+public:
+	/// Look up the word. A negative max_cost means no cost threshold;
+	/// a zero cap means no cap.
+	LGDisjunctEnumerator(Dictionary, const std::string& word,
+	                     double max_cost = -1.0, size_t cap = 0);
+
+	/// True if the dictionary has the word at all.
+	bool known(void) const { return 0 < _roots.size(); }
+
+	/// Return up to n more disjuncts. Returns fewer only when there
+	/// are no more; an empty result means the enumeration is done.
+	/// The Atoms are not in any AtomSpace.
+	HandleSeq next(size_t n = 1);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_LG_DISJUNCT_ENUMERATOR_H
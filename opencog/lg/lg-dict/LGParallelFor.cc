@@ -0,0 +1,89 @@
+/*
+ * LGParallelFor.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <link-grammar/link-includes.h>
+
+#include "LGParallelFor.h"
+
+using namespace opencog;
+
+// Defined in LGDictNode.cc
+void error_handler(lg_errinfo *ei, void *data);
+
+void opencog::lg_parallel_for(size_t n, size_t nthreads, size_t grain,
+                              const std::function<void(size_t, size_t)>& fn)
+{
+	if (0 == nthreads)
+	{
+		nthreads = std::thread::hardware_concurrency();
+		if (0 == nthreads) nthreads = 1;
+	}
+	nthreads = std::min(nthreads, n / std::max<size_t>(grain, 1));
+
+	// The LG error handler is per-thread.
+	lg_error_set_handler(error_handler, nullptr);
+
+	// Starting threads costs more than a few small calls do.
+	if (nthreads <= 1)
+	{
+		for (size_t i = 0; i < n; i++)
+			fn(i, 0);
+		return;
+	}
+
+	std::atomic<size_t> next(0);
+	std::mutex mtx;
+	std::exception_ptr failure;
+	auto worker = [&](size_t t)
+	{
+		lg_error_set_handler(error_handler, nullptr);
+		for (size_t i = next++; i < n; i = next++)
+		{
+			try { fn(i, t); }
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lck(mtx);
+				if (not failure) failure = std::current_exception();
+
+				// Stop the other threads, too.
+				next = n;
+			}
+		}
+	};
+
+	std::vector<std::thread> pool;
+	for (size_t t = 1; t < nthreads; t++)
+		pool.emplace_back(worker, t);
+	worker(0);
+	for (std::thread& th : pool)
+		th.join();
+
+	if (failure) std::rethrow_exception(failure);
+}
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,52 @@
+/*
+ * LGParallelFor.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LG_PARALLEL_FOR_H
+#define _OPENCOG_LG_PARALLEL_FOR_H
+
+#include <cstddef>
+#include <functional>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// Run fn(i, t) for each i from 0 to n-1, on up to `nthreads` threads;
+/// zero means one per CPU. The items are handed out one at a time;
+/// `t` is the number of the thread running the call, from zero up,
+/// for callers that keep per-thread state.
+///
+/// Each thread gets at least `grain` items. If there are not enough
+/// for two threads, all of the calls run on the calling thread, and
+/// no threads are started. Otherwise, the calling thread is one of
+/// the workers, as thread zero.
+///
+/// If a call throws, no more items are handed out, and the first
+/// exception is rethrown once the running calls are done.
+void lg_parallel_for(size_t n, size_t nthreads, size_t grain,
+                     const std::function<void(size_t, size_t)>& fn);
+
+/** @}*/
+}
+
+#endif // _OPENCOG_LG_PARALLEL_FOR_H
@@ -0,0 +1,103 @@
+/*
+ * LGLinkageValue.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "LGLinkageValue.h"
+
+using namespace opencog;
+void error_handler(lg_errinfo *ei, void *data);
+
+LGParsedSentence::LGParsedSentence(const LGParseLinkPtr& parser,
+                                   const LgDictNodePtr& ldn,
+                                   const LgDictionaryPtr& dict,
+                                   const AtomSpacePtr& asp,
+                                   const char* phrstr,
+                                   Sentence sent, Parse_Options opts,
+                                   std::vector<int>&& picks) :
+	_parser(parser), _ldn(ldn), _dict(dict), _asp(asp), _phrase(phrstr),
+	_sent(sent), _opts(opts), _picks(std::move(picks))
+{
+	// The interner points into the phrase; it must be our copy.
+	_intern.reset(new LGParseInterner(_asp.get(), _phrase.c_str()));
+	_unread = _picks.size();
+	if (0 == _unread) release();
+}
+
+LGParsedSentence::~LGParsedSentence()
+{
+	if (_sent) release();
+}
+
+/// Give everything back to Link Grammar.
+void LGParsedSentence::release()
+{
+	sentence_delete(_sent);
+	_sent = nullptr;
+	_ldn->return_parse_options(_opts);
+	_opts = nullptr;
+	_intern.reset();
+	_dict.reset();
+}
+
+/// Runs on whatever thread looks at the linkage first.
+ValuePtr LGParsedSentence::build(size_t i)
+{
+	// The LG error handler is per-thread.
+	lg_error_set_handler(error_handler, nullptr);
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	Linkage lkg = linkage_create(_picks[i], _sent, _opts);
+	ValuePtr vp;
+	try
+	{
+		vp = _parser->make_linkage(lkg, *_intern);
+	}
+	catch (...)
+	{
+		linkage_delete(lkg);
+		throw;
+	}
+	linkage_delete(lkg);
+
+	// The last one out turns off the lights.
+	if (0 == --_unread) release();
+	return vp;
+}
+
+// ==============================================================
+
+LGLinkageValue::LGLinkageValue(const std::shared_ptr<LGParsedSentence>& sent,
+                               size_t idx) :
+	LinkValue(LG_LINKAGE_VALUE), _sent(sent), _idx(idx)
+{
+}
+
+/// Convert the linkage, the first time that it is looked at, and
+/// then let go of the sentence.
+void LGLinkageValue::update() const
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	if (nullptr == _sent) return;
+
+	_value = LinkValueCast(_sent->build(_idx))->value();
+	_sent.reset();
+}
+
+/* ===================== END OF FILE ===================== */
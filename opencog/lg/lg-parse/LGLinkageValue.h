@@ -0,0 +1,102 @@
+/*
+ * LGLinkageValue.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LG_LINKAGE_VALUE_H
+#define _OPENCOG_LG_LINKAGE_VALUE_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <link-grammar/link-includes.h>
+
+#include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/lg/lg-dict/LGDictNode.h>
+#include <opencog/lg/lg-parse/LGParseInterner.h>
+#include <opencog/lg/lg-parse/LGParseLink.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// A parsed sentence, whose linkages have not yet been converted to
+/// Atoms. It keeps the LG Sentence, Parse_Options and Dictionary alive
+/// until every linkage has been converted, or until nothing refers to
+/// it anymore, whichever comes first. The linkages themselves are
+/// created one at a time, as they are converted.
+class LGParsedSentence
+{
+	std::mutex _mtx;
+	LGParseLinkPtr _parser;
+	LgDictNodePtr _ldn;
+	LgDictionaryPtr _dict;
+	AtomSpacePtr _asp;
+	std::string _phrase;
+
+	Sentence _sent;
+	Parse_Options _opts;
+	std::vector<int> _picks;
+	std::unique_ptr<LGParseInterner> _intern;
+	size_t _unread;
+
+	void release();
+
+public:
+	LGParsedSentence(const LGParseLinkPtr&, const LgDictNodePtr&,
+	                 const LgDictionaryPtr&, const AtomSpacePtr&, const char*,
+	                 Sentence, Parse_Options, std::vector<int>&&);
+	~LGParsedSentence();
+
+	size_t size() const { return _picks.size(); }
+
+	// Convert linkage `i` to Atoms. Each linkage is converted once.
+	ValuePtr build(size_t);
+};
+
+/// One linkage of a parse, converted to Atoms only when it is looked
+/// at. Until then, it holds nothing but a reference to the sentence.
+/// Once converted, it is an ordinary LinkValue, holding exactly what
+/// the LgParse* link would have placed there, had it not been lazy.
+class LGLinkageValue : public LinkValue
+{
+protected:
+	mutable std::mutex _mtx;
+	mutable std::shared_ptr<LGParsedSentence> _sent;
+	size_t _idx;
+
+	virtual void update() const;
+
+public:
+	LGLinkageValue(const std::shared_ptr<LGParsedSentence>&, size_t);
+	virtual ~LGLinkageValue() {}
+};
+
+VALUE_PTR_DECL(LGLinkageValue);
+CREATE_VALUE_DECL(LGLinkageValue);
+
+/** @}*/
+}
+
+#endif // _OPENCOG_LG_LINKAGE_VALUE_H
@@ -0,0 +1,164 @@
+/*
+ * LGParseCache.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/atoms/value/LinkValue.h>
+#include "LGParseCache.h"
+
+using namespace opencog;
+
+/// Rough estimate of the memory held by a cache entry. Parse results
+/// are nested LinkValues; count the slots in them. The Atoms are
+/// shared with the AtomSpace, and are not counted.
+static size_t result_bytes(const ValuePtr& vp)
+{
+	size_t bytes = sizeof(LinkValue) + 16;
+	if (not vp->is_type(LINK_VALUE)) return bytes;
+
+	for (const ValuePtr& v : LinkValueCast(vp)->value())
+	{
+		bytes += sizeof(ValuePtr);
+		if (v->is_type(LINK_VALUE))
+			bytes += result_bytes(v);
+	}
+	return bytes;
+}
+
+/// A cached result is good only as long as all of its Atoms are
+/// still in an AtomSpace. If some were extracted, re-parse.
+static bool still_valid(const ValuePtr& vp)
+{
+	if (vp->is_atom())
+		return nullptr != HandleCast(vp)->getAtomSpace();
+
+	if (not vp->is_type(LINK_VALUE)) return true;
+
+	for (const ValuePtr& v : LinkValueCast(vp)->value())
+		if (not still_valid(v)) return false;
+
+	return true;
+}
+
+/// Set the maximum number of entries, and the maximum estimated
+/// memory use, in bytes. Setting zero entries turns the cache off,
+/// and empties it. Setting zero bytes means no memory limit.
+void LGParseCache::set_limits(size_t max_entries, size_t max_bytes)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_max_entries = max_entries;
+	_max_bytes = max_bytes;
+	evict();
+}
+
+/// Drop least-recently-used entries until under the limits.
+/// Caller must hold the lock.
+void LGParseCache::evict(void)
+{
+	while (0 < _lru.size() and
+	       (_max_entries < _lru.size() or
+	        (0 < _max_bytes and _max_bytes < _stats.bytes)))
+	{
+		Entry& old = _lru.back();
+		_stats.bytes -= old.bytes;
+		_index.erase(old.key);
+		_lru.pop_back();
+		_stats.evictions++;
+	}
+	_stats.entries = _lru.size();
+}
+
+/// Return the cached result, or nullptr if there isn't one. The key
+/// has the address of the AtomSpace in it, but addresses get re-used;
+/// so check that the AtomSpace that the entry was made in is still
+/// alive, and is the one that is asking.
+ValuePtr LGParseCache::lookup(const std::string& key, const AtomSpace* as)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	auto it = _index.find(key);
+	if (_index.end() == it)
+	{
+		_stats.misses++;
+		return nullptr;
+	}
+
+	std::shared_ptr<AtomSpace> space(it->second->space.lock());
+	if (space.get() != as or not still_valid(it->second->result))
+	{
+		_stats.bytes -= it->second->bytes;
+		_lru.erase(it->second);
+		_index.erase(it);
+		_stats.entries = _lru.size();
+		_stats.misses++;
+		return nullptr;
+	}
+
+	// Move to the front.
+	_lru.splice(_lru.begin(), _lru, it->second);
+	_stats.hits++;
+	return _lru.front().result;
+}
+
+void LGParseCache::insert(const std::string& key, const ValuePtr& result,
+                          const std::shared_ptr<AtomSpace>& space)
+{
+	if (not enabled()) return;
+
+	size_t bytes = result_bytes(result) + 2 * key.size() + sizeof(Entry);
+
+	std::lock_guard<std::mutex> lck(_mtx);
+
+	// Some other thread may have parsed the same sentence.
+	auto it = _index.find(key);
+	if (_index.end() != it)
+	{
+		_stats.bytes -= it->second->bytes;
+		_lru.erase(it->second);
+		_index.erase(it);
+	}
+
+	_lru.push_front({key, result, space, bytes});
+	_index[key] = _lru.begin();
+	_stats.bytes += bytes;
+	evict();
+}
+
+void LGParseCache::clear(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_lru.clear();
+	_index.clear();
+	_stats.bytes = 0;
+	_stats.entries = 0;
+}
+
+LGParseCache::Stats LGParseCache::get_stats(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	return _stats;
+}
+
+LGParseCache& opencog::lg_parse_cache(void)
+{
+	static LGParseCache cache;
+	return cache;
+}
+
+/* ===================== END OF FILE ===================== */
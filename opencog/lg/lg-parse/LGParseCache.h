@@ -0,0 +1,101 @@
+/*
+ * LGParseCache.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LG_PARSE_CACHE_H
+#define _OPENCOG_LG_PARSE_CACHE_H
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <opencog/atoms/value/Value.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+class AtomSpace;
+
+/// Bounded LRU cache of parse results.
+///
+/// Corpora often contain the same sentence many times over. This
+/// cache maps a sentence, together with everything else that affects
+/// the parse (dictionary, number of linkages, output type, options),
+/// to the LinkValue that the parse produced. It is bounded both by
+/// the number of entries and by an estimate of the memory they use.
+/// It is off until limits are set.
+class LGParseCache
+{
+public:
+	struct Stats
+	{
+		size_t hits = 0;
+		size_t misses = 0;
+		size_t evictions = 0;
+		size_t entries = 0;
+		size_t bytes = 0;
+	};
+
+private:
+	struct Entry
+	{
+		std::string key;
+		ValuePtr result;
+		std::weak_ptr<AtomSpace> space;
+		size_t bytes;
+	};
+
+	std::mutex _mtx;
+	std::list<Entry> _lru;  // Most recently used first.
+	std::unordered_map<std::string, std::list<Entry>::iterator> _index;
+
+	std::atomic<size_t> _max_entries{0};
+	size_t _max_bytes = 0;
+	Stats _stats;
+
+	void evict(void);
+
+public:
+	bool enabled(void) const { return 0 < _max_entries; }
+	void set_limits(size_t max_entries, size_t max_bytes);
+
+	// Results hold Atoms, and are good only in the AtomSpace that
+	// they were made in; an entry is handed back only if that
+	// AtomSpace is still around, and is the one asked for.
+	ValuePtr lookup(const std::string&, const AtomSpace*);
+	void insert(const std::string&, const ValuePtr&,
+	            const std::shared_ptr<AtomSpace>&);
+	void clear(void);
+
+	Stats get_stats(void);
+};
+
+/// The process-wide parse cache.
+LGParseCache& lg_parse_cache(void);
+
+/** @}*/
+}
+#endif // _OPENCOG_LG_PARSE_CACHE_H
@@ -0,0 +1,203 @@
+/*
+ * LGParseInterner.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstring>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/lg/types/atom_types.h>
+#include "LGParseInterner.h"
+
+using namespace opencog;
+
+LGParseInterner::LGParseInterner(AtomSpace* as, const char* phrstr) :
+	_as(as), _phrstr(phrstr)
+{
+}
+
+Handle LGParseInterner::node(Type t, std::string&& name)
+{
+	return _as->add_node(t, std::move(name));
+}
+
+Handle LGParseInterner::link(Type t, HandleSeq&& oset)
+{
+	return _as->add_link(t, std::move(oset));
+}
+
+Handle LGParseInterner::link(Type t, const Handle& a, const Handle& b)
+{
+	return _as->add_link(t, a, b);
+}
+
+/// Get the word string, as it appears in the sentence.
+std::string LGParseInterner::word_string(Linkage lkg, int w,
+                                         const char* phrstr)
+{
+	size_t sb = linkage_get_word_byte_start(lkg, w);
+	size_t eb = linkage_get_word_byte_end(lkg, w);
+
+	// Problem: the default LG API supplies the word together with
+	// the subscript, and with word regex and guess-marks. We really
+	// do NOT want that crud. So use the byte offsets to get the
+	// actual original string.  Since LEFT-WALL and RIGHT-WALL have
+	// no offsets, we need to handle those differently.
+	if (eb != sb) // Neither are equal to -1
+	{
+		std::string rv(phrstr + sb, eb - sb);
+		return rv;
+	}
+
+	const char* wrd = linkage_get_word(lkg, w);
+
+	// LEFT-WALL is not an ordinary word. Its special. Make it
+	// extra-special by adding "illegal" punctuation to it.
+	if (0 == w and 0 == strcmp(wrd, "LEFT-WALL"))
+		return "###LEFT-WALL###";
+
+	int nwords = linkage_get_num_words(lkg);
+	if (nwords-1 == w and 0 == strcmp(wrd, "RIGHT-WALL"))
+		return "###RIGHT-WALL###";
+
+	return wrd;
+}
+
+/// Get the WordNode for word `w` of the linkage.
+Handle LGParseInterner::word(Linkage lkg, int w)
+{
+	size_t sb = linkage_get_word_byte_start(lkg, w);
+	size_t eb = linkage_get_word_byte_end(lkg, w);
+
+	// The byte span says it all; the string is never built twice.
+	if (eb != sb)
+	{
+		uint64_t key = (((uint64_t) sb) << 32) | (uint64_t) eb;
+		Handle& h = _words[key];
+		if (nullptr == h)
+			h = node(WORD_NODE, std::string(_phrstr + sb, eb - sb));
+		return h;
+	}
+
+	std::string wrd(word_string(lkg, w, _phrstr));
+	Handle& h = _named[wrd];
+	if (nullptr == h)
+		h = node(WORD_NODE, std::move(wrd));
+	return h;
+}
+
+/// Get the WordNodes for all of the words in the linkage.
+HandleSeq LGParseInterner::words(Linkage lkg)
+{
+	HandleSeq words;
+	int nwords = linkage_get_num_words(lkg);
+	words.reserve(nwords);
+	for (int w=0; w<nwords; w++)
+		words.emplace_back(word(lkg, w));
+	return words;
+}
+
+/// Get the BondNode for a link label.
+Handle LGParseInterner::bond(const char* label)
+{
+	Handle& h = _bonds[label];
+	if (nullptr == h)
+		h = node(BOND_NODE, label);
+	return h;
+}
+
+/// Get the ConnectorLink joining `word` to a Section; `left` if
+/// the word is to the left of the Section's word.
+Handle LGParseInterner::connector(const Handle& word, bool left)
+{
+	Handle& h = left ? _left[word] : _right[word];
+	if (h) return h;
+
+	// The SexNodes are made only if Sections are wanted.
+	Handle& dir = left ? _minus : _plus;
+	if (nullptr == dir)
+		dir = node(SEX_NODE, left ? "-" : "+");
+	h = link(CONNECTOR, word, dir);
+	return h;
+}
+
+/// Convert the disjunct on word `w` to LG-style Atomese, using LgConn
+/// and LgConDir. Each connector is built only the first time that it
+/// is seen in the sentence.
+HandleSeq LGParseInterner::lg_conseq(Linkage lkg, int w)
+{
+	// This requires parsing a string. Fortunately, the
+	// string is a very simple format.
+	const char* djstr = linkage_get_disjunct_str(lkg, w);
+
+	HandleSeq conseq;
+	const char* p = djstr;
+	while (*p)
+	{
+		while (' ' == *p) p++;
+		if (0 == *p) break;
+		const char* s = strchr(p, ' ');
+		size_t len = (NULL == s) ? strlen(p) : s-p;
+
+		std::string key(p, len);
+		auto it = _lg_connectors.find(key);
+		if (_lg_connectors.end() == it)
+			it = _lg_connectors.emplace(std::move(key),
+				add_lg_connector(p, len, djstr)).first;
+
+		conseq.push_back(it->second);
+		p += len;
+	}
+
+	return conseq;
+}
+
+/// Build one LgConnector out of `len` bytes of connector string,
+/// e.g. "@Ss+".
+Handle LGParseInterner::add_lg_connector(const char* p, size_t len,
+                                         const char* djstr)
+{
+	bool multi = false;
+	if ('@' == *p) { multi = true; p++; len--; }
+
+	// The last byte is the direction.
+	len--;
+	char cstr[60];
+	if (60 <= len)
+		throw RuntimeException(TRACE_INFO,
+			"LGParseLink: Dictionary has a bug; Unexpectedly long connector=%s", djstr);
+	strncpy(cstr, p, len);
+	cstr[len] = 0;
+	Handle con(node(LG_CONN_NODE, cstr));
+	cstr[0] = *(p+len);
+	cstr[1] = 0;
+	Handle dir(node(LG_CONN_DIR_NODE, cstr));
+
+	HandleSeq cono;
+	cono.push_back(con);
+	cono.push_back(dir);
+	if (multi)
+	{
+		Handle mu(node(LG_CONN_MULTI_NODE, "@"));
+		cono.push_back(mu);
+	}
+	return link(LG_CONNECTOR, std::move(cono));
+}
+
+/* ===================== END OF FILE ===================== */
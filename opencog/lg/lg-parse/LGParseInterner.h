@@ -0,0 +1,94 @@
+/*
+ * LGParseInterner.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LG_PARSE_INTERNER_H
+#define _OPENCOG_LG_PARSE_INTERNER_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include <link-grammar/link-includes.h>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// Sentence-scoped intern table for the Atoms of a parse.
+///
+/// The linkages of one sentence all draw on the same small set of
+/// words, link labels and connectors. Rather than going through the
+/// AtomSpace for every one of them, in every linkage, each is added
+/// once and remembered here. Words are keyed by their byte span in
+/// the sentence, so that no strings need to be built for them.
+///
+/// Not thread-safe; use one per sentence, per thread.
+class LGParseInterner
+{
+	AtomSpace* _as;
+	const char* _phrstr;
+
+	// Words, keyed by byte start and end in the sentence.
+	std::unordered_map<uint64_t, Handle> _words;
+
+	// Words without a byte span: the walls, mostly.
+	std::unordered_map<std::string, Handle> _named;
+
+	// BondNodes, keyed by link label.
+	std::unordered_map<std::string, Handle> _bonds;
+
+	// LgConnectors, keyed by the connector string, e.g. "@Ss+".
+	std::unordered_map<std::string, Handle> _lg_connectors;
+
+	// Section connectors, keyed by word.
+	std::unordered_map<Handle, Handle> _left;
+	std::unordered_map<Handle, Handle> _right;
+
+	Handle _minus;
+	Handle _plus;
+
+	Handle add_lg_connector(const char*, size_t, const char*);
+	Handle node(Type, std::string&&);
+
+public:
+	LGParseInterner(AtomSpace*, const char*);
+
+	// The word, as it appears in the sentence, without subscripts.
+	static std::string word_string(Linkage, int, const char*);
+
+	Handle word(Linkage, int);
+	HandleSeq words(Linkage);
+	Handle bond(const char*);
+	HandleSeq lg_conseq(Linkage, int);
+	Handle connector(const Handle&, bool);
+
+	Handle link(Type, HandleSeq&&);
+	Handle link(Type, const Handle&, const Handle&);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_LG_PARSE_INTERNER_H
@@ -22,21 +22,29 @@
  */
 
 #include <atomic>
+#include <climits>
+#include <cmath>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <unordered_map>
 #include <link-grammar/link-includes.h>
-#if LINK_MAJOR_VERSION == 5 && LINK_MINOR_VERSION >= 11
-#include <link-grammar/dict-atomese.h>
-#endif
 
 #include <opencog/atoms/atom_types/NameServer.h>
 #include <opencog/atoms/base/Node.h>
 #include <opencog/atoms/core/NumberNode.h>
+#include <opencog/atoms/value/FloatValue.h>
 #include <opencog/atoms/value/LinkValue.h>
 #include <opencog/atoms/value/StringValue.h>
 #include <opencog/atoms/value/VoidValue.h>
 #include <opencog/atomspace/AtomSpace.h>
-#include <opencog/persist/api/StorageNode.h>
 #include <opencog/persist/storage/storage_types.h>
+#include <opencog/util/Logger.h>
 #include <opencog/lg/lg-dict/LGDictNode.h>
+#include <opencog/lg/lg-dict/LGParallelFor.h>
+#include "LGParseCache.h"
+#include "LGParseInterner.h"
+#include "LGLinkageValue.h"
 #include "LGParseLink.h"
 
 using namespace opencog;
@@ -50,6 +58,7 @@ void error_handler(lg_errinfo *ei, void *data);
 ///         NumberNode  6   -- optional, number of parses.
 ///         AtomSpace  foo  -- optional, AtomSpace holding dict info.
 ///         StorageNode bar -- optional, StorageNode holding dict info.
+///         AnchorNode baz  -- optional, holds parse options; see below.
 ///
 /// When executed, the result of parsing the phrase text, using the
 /// specified dictionary, is placed in the atomspace.  Execution
@@ -72,6 +81,65 @@ void error_handler(lg_errinfo *ei, void *data);
 /// will use the AtomSpace contents only; the entire dictionary must
 /// be present in the AtomSpace.
 ///
+/// If the first argument is executable, and it returns a LinkValue
+/// holding more than one Node or StringValue, or a StringValue holding
+/// more than one string, then the sentences are parsed as a batch.
+/// The batch is spread over a pool of worker threads; the size of the
+/// pool is controlled by a FloatValue at the key
+/// (PredicateNode "*-lg-parse-threads-*") on either the LgParseLink or
+/// the LgDictNode, and defaults to the number of CPU cores. The result
+/// is a LinkValue holding one parse result per sentence, in the same
+/// order as the input.
+///
+/// Linkages can also be converted into Atoms on several threads. When
+/// many linkages are asked for, this can take longer than the parse
+/// itself. The number of threads is set with
+/// (PredicateNode "*-lg-linkage-threads-*"), and defaults to one. In
+/// a batch, only the threads left over from the parsing are used.
+///
+/// The LgParseCompact variant creates no Atoms at all; it returns the
+/// words, link labels and disjuncts as strings, once per sentence, and
+/// the linkages as numbers indexing them; see make_compact() below.
+///
+/// The LgParseCounts variant creates the same Atoms as LgParseLink,
+/// but instead of returning them, it increments a count on each bond,
+/// disjunct and Section, and returns only a summary; see
+/// count_linkages() below.
+///
+/// Parse options are read from FloatValues placed at the keys listed
+/// below. They are looked for, in order, on the optional AnchorNode,
+/// which must be the last argument, then on the LgParseLink itself,
+/// and finally on the LgDictNode. The first one found wins. They are
+/// read on every execution, so changing them does not require the
+/// dictionary to be reloaded. The AnchorNode makes it possible for
+/// different kinds of requests (e.g. interactive and bulk) to use
+/// different budgets with the same dictionary.
+///
+///     *-lg-parse-threads-*    Worker threads. Default: #cores.
+///     *-lg-linkage-threads-*  Threads converting the linkages of one
+///                             sentence. Default: 1.
+///     *-lg-max-parse-time-*   Parse timeout, in seconds. Link Grammar
+///                             counts whole seconds, so this is rounded
+///                             up. Default: 150.
+///     *-lg-linkage-limit-*    Max linkages to consider. Default: 15000.
+///     *-lg-null-count-*       Two numbers: the min and max number of
+///                             unlinked words. Default: first try with
+///                             none, then, if there is no parse, retry
+///                             allowing any number of them.
+///     *-lg-disjunct-cost-*    Max disjunct cost; disjuncts costing
+///                             more are pruned. Default: LG's default.
+///     *-lg-short-length-*     Max length of a link, in words. Default:
+///                             LG's default.
+///     *-lg-spell-guess-*      Number of spelling guesses for unknown
+///                             words; zero disables. Default: LG's.
+///     *-lg-lazy-*             If non-zero, linkages are converted to
+///                             Atoms only when they are looked at; see
+///                             LGLinkageValue. Default: 0.
+///
+/// The keys are PredicateNodes, e.g.
+///     (cog-set-value! (LgDictNode "en")
+///         (Predicate "*-lg-max-parse-time-*") (FloatValue 2))
+///
 /// The LgParseLink is a kind of FunctionLink, and can thus be used in
 /// any expression that FunctionLinks can be used with.
 ///
@@ -79,7 +147,13 @@ void LGParseLink::init()
 {
 	const HandleSeq& oset = _outgoing;
 
+	// The options anchor is always last, so that the positions of
+	// the other arguments do not depend on it.
 	size_t osz = oset.size();
+	if (2 < osz and ANCHOR_NODE == oset[osz-1]->get_type())
+		osz--;
+	_nargs = osz;
+
 	if (2 > osz or 5 < osz)
 		throw InvalidParamException(TRACE_INFO,
 			"LGParseLink: Expecting two to five arguments, got %lu", osz);
@@ -178,9 +252,38 @@ LGParseBonds::LGParseBonds(const HandleSeq&& oset, Type t)
 	init();
 }
 
+LGParseCompact::LGParseCompact(const HandleSeq&& oset, Type t)
+	: LGParseLink(std::move(oset), t)
+{
+	// Type must be as expected
+	if (not nameserver().isA(t, LG_PARSE_COMPACT))
+	{
+		const std::string& tname = nameserver().getTypeName(t);
+		throw InvalidParamException(TRACE_INFO,
+			"Expecting an LgParseCompact, got %s", tname.c_str());
+	}
+	init();
+}
+
+LGParseCounts::LGParseCounts(const HandleSeq&& oset, Type t)
+	: LGParseLink(std::move(oset), t)
+{
+	// Type must be as expected
+	if (not nameserver().isA(t, LG_PARSE_COUNTS))
+	{
+		const std::string& tname = nameserver().getTypeName(t);
+		throw InvalidParamException(TRACE_INFO,
+			"Expecting an LgParseCounts, got %s", tname.c_str());
+	}
+	init();
+}
+
 // =================================================================
 
-ValuePtr LGParseLink::execute(AtomSpace* as, bool silent)
+/// Verify that the arguments are fit for execution, and return the
+/// dictionary to parse with. The caller must hold on to it for as
+/// long as it is parsing; the dictionary may be reloaded meanwhile.
+LgDictionaryPtr LGParseLink::get_dictionary() const
 {
 	// Executable links are a subset of those that can be declared.
 	// Declarations can include VariableNodes & etc. but for execution,
@@ -190,17 +293,17 @@ ValuePtr LGParseLink::execute(AtomSpace* as, bool silent)
 		throw InvalidParamException(TRACE_INFO,
 			"LGParseLink: Invalid outgoing set at 1; expecting LgDictNode");
 
-	if (3 <= _outgoing.size() and
+	if (3 <= _nargs and
 	   NUMBER_NODE != _outgoing[2]->get_type())
 		throw InvalidParamException(TRACE_INFO,
 			"LGParseLink: Invalid outgoing set at 2; expecting NumberNode");
 
-	if (4 <= _outgoing.size() and
+	if (4 <= _nargs and
 	   ATOM_SPACE != _outgoing[3]->get_type())
 		throw InvalidParamException(TRACE_INFO,
 			"LGParseLink: Invalid outgoing set at 3; expecting AtomSpace");
 
-	if (5 <= _outgoing.size() and
+	if (5 <= _nargs and
 	   not nameserver().isA(_outgoing[4]->get_type(), STORAGE_NODE))
 		throw InvalidParamException(TRACE_INFO,
 			"LGParseLink: Invalid outgoing set at 4; expecting StorageNode");
@@ -210,149 +313,363 @@ ValuePtr LGParseLink::execute(AtomSpace* as, bool silent)
 	// because we don't know what thread we are in.
 	lg_error_set_handler(error_handler, nullptr);
 
-#if LINK_MAJOR_VERSION == 5 && LINK_MINOR_VERSION >= 11
-	// Set up the dictionary config, if any.
-	// This must happen before ldn->get_dictionary() because the
-	// setup is stateful. This seems buggy, but is adequate for now.
-	// XXX FIXME. This should be part of the LgDictNode but since
-	// LgDictNode is a node, not a link, its hard to pass args.
-	// We would need to wrap it with a StateLink, or maybe use the
-	// new-fangled "sensory API". Sheesh.
-	if (4 <= _outgoing.size())
-	{
-		AtomSpacePtr asp = AtomSpaceCast(_outgoing[3]);
-		StorageNodePtr stnp;
-		if (5 <= _outgoing.size())
-			stnp = StorageNodeCast(_outgoing[4]);
-
-		lg_config_atomspace(asp, stnp);
-	}
-#endif
+	// The AtomSpace and StorageNode, if any, configure an
+	// AtomSpace-backed dictionary. The LgDictNode keeps one open
+	// dictionary per configuration.
+	Handle asp, stnp;
+	if (4 <= _nargs) asp = _outgoing[3];
+	if (5 <= _nargs) stnp = _outgoing[4];
 
 	// Get the dictionary
 	LgDictNodePtr ldn(LgDictNodeCast(_outgoing[1]));
-	Dictionary dict = ldn->get_dictionary();
+	LgDictionaryPtr dict = ldn->get_dictionary(asp, stnp);
 	if (nullptr == dict)
 		throw InvalidParamException(TRACE_INFO,
 			"LgParseLink requires valid dictionary! \"%s\" was given.",
 			ldn->get_name().c_str());
 
+	return dict;
+}
+
+ValuePtr LGParseLink::execute(AtomSpace* as, bool silent)
+{
+	LgDictionaryPtr dict = get_dictionary();
+	LgParseSettings settings = get_settings();
+
 	// Set up the sentence. Several forms are supported:
 	// 1) Hard-coded as (PhraseNode "Some sentence to parse")
 	// 2) Some executable atom that returns a Node or StringValue
 	// 3) Some executable atom that returns a stream of strings.
-	//    This third case is interesting but experimental. Might be
-	//    buggy.
+	//    Each execution pulls and parses one sentence. To run this
+	//    as a pipeline, wrap it with an LgParseStream.
+	// 4) Some executable atom that returns a LinkValue holding more
+	//    than one Node or StringValue, or a StringValue holding more
+	//    than one string. This is a batch; the sentences are parsed
+	//    concurrently, and one result is returned per sentence.
 	ValuePtr phrsv(_outgoing[0]);
 	if (_outgoing[0]->is_executable())
 	{
 		phrsv = _outgoing[0]->execute(as, silent);
 		if (phrsv->is_type(LINK_VALUE))
 		{
-			// For now, only one at a time!?
 			const ValueSeq& vlist = LinkValueCast(phrsv)->value();
 			if (1 != vlist.size())
-				throw InvalidParamException(TRACE_INFO,
-					"LGParseLink: Expecting Value of length one");
+				return parse_batch(vlist, dict, settings, as);
 			phrsv = vlist[0];
 		}
+		else if (phrsv->is_type(STRING_VALUE) and
+		         1 < StringValueCast(phrsv)->value().size())
+		{
+			ValueSeq vlist;
+			for (const std::string& str : StringValueCast(phrsv)->value())
+				vlist.emplace_back(createStringValue(str));
+			return parse_batch(vlist, dict, settings, as);
+		}
 	}
 
-	const char* phrstr = nullptr;
+	// Voids and empty StringValues are end-of-file markers.
+	// Pass them on.
+	std::string phrase;
+	if (not get_phrase(phrsv, phrase))
+		return createVoidValue();
+
+	return parse_phrase(phrase.c_str(), dict, settings, as);
+}
+
+/// Unpack the sentence text from a Node or from a StringValue holding
+/// a single string. Returns false if the Value is an end-of-file
+/// marker: either a VoidValue, or a zero-length StringValue.
+bool LGParseLink::get_phrase(const ValuePtr& phrsv, std::string& phrase)
+{
 	if (phrsv->is_type(NODE))
-		phrstr = HandleCast(phrsv)->get_name().c_str();
-	else
+	{
+		phrase = HandleCast(phrsv)->get_name();
+		return true;
+	}
+
 	if (phrsv->is_type(STRING_VALUE))
 	{
 		const std::vector<std::string>& sli = StringValueCast(phrsv)->value();
 
-		// Zero-length StringValue denotes end-of-file. Pass it on.
+		// Zero-length StringValue denotes end-of-file.
 		if (0 == sli.size())
-			return createVoidValue();
+			return false;
 
 		if (1 != sli.size())
 			throw InvalidParamException(TRACE_INFO,
 				"LGParseLink: Expecting Value of length one");
-		phrstr = sli[0].c_str();
+		phrase = sli[0];
+		return true;
 	}
+
 	// Voids are a form of end-of-file marker
-	else if (VOID_VALUE == phrsv->get_type())
-		return phrsv;
-	else
-		throw InvalidParamException(TRACE_INFO,
-			"LGParseLink: Expecting Node or StringValue, got %s",
-			phrsv->to_string().c_str());
+	if (VOID_VALUE == phrsv->get_type())
+		return false;
 
-	// Now, actually parse.
-	Sentence sent = sentence_create(phrstr, dict);
-	if (nullptr == sent)
-		throw FatalErrorException(TRACE_INFO,
-			"LGParseLink: Unexpected parser failure!");
+	throw InvalidParamException(TRACE_INFO,
+		"LGParseLink: Expecting Node or StringValue, got %s",
+		phrsv->to_string().c_str());
+}
+
+/// Look up a parse option. The options anchor, if any, is checked
+/// first, then this link, then the dictionary node. Returns false if
+/// the option is not set anywhere.
+bool LGParseLink::get_option(const Handle& key,
+                             std::vector<double>& val) const
+{
+	const Atom* where[3] = {nullptr, this, _outgoing[1].get()};
+	if (_nargs < _outgoing.size())
+		where[0] = _outgoing[_nargs].get();
+
+	for (const Atom* atom : where)
+	{
+		if (nullptr == atom) continue;
+		ValuePtr vp = atom->getValue(key);
+		if (nullptr == vp or not vp->is_type(FLOAT_VALUE)) continue;
+
+		const std::vector<double>& fv = FloatValueCast(vp)->value();
+		if (0 == fv.size()) continue;
+		val = fv;
+		return true;
+	}
+	return false;
+}
 
-	// Work with the default parse options (mostly).
-	// Suppress printing of combinatorial-overflow warning.
-	// Set timeout to 150 seconds; the default is infinite.
-#define MAX_PARSE_TIME 150
-	Parse_Options opts = parse_options_create();
-
-	// Set to 0 to disable all messages (including warnings).
-	// Set to 1 to get basic info and warnings.
-	// Set to 2 to get timing info.
-	// Set to 6 to get pruning/power-pruning info.
-	// We want 0 here, because otherwise the log fills up with
-	// [WARN] Combinatorial explosion! messages. Yuck.
-	parse_options_set_verbosity(opts, 0);
-	parse_options_set_max_parse_time(opts, MAX_PARSE_TIME);
-
-	// For the MST/MPG parses, the disjuncts consist of all-optional
-	// connectors, and the number of parses generated is huge. If we
-	// expect to have a good chance of finding the linkage with the
-	// minimal cost, we have to look at a lot of them. This does
-	// impact performance; I don't know how much. Storage is about
-	// 120 bytes per linkage, so 15000 linkages == 2MBytes.
-#define DEFAULT_NUM_LINKAGES 15000
-	parse_options_set_linkage_limit(opts, DEFAULT_NUM_LINKAGES);
-
-	// For the ANY language, this code is being used for sampling.
-	// In this case, we are not concerned about reproducibility,
-	// but want different, truly random results each time through.
-	// Viz, every time we have a four-word sentence, we want a
-	// different parse for it, each time. Bug #3065.
-	parse_options_set_repeatable_rand(opts, 0);
+/// The key that LgParseCounts places counts at. It can be set by
+/// placing the key Atom at (PredicateNode "*-lg-count-key-*"), in
+/// the same places as the parse options.
+Handle LGParseLink::get_count_key() const
+{
+	static const Handle key_key(createNode(PREDICATE_NODE, "*-lg-count-key-*"));
+	static const Handle default_key(createNode(PREDICATE_NODE, "*-lg-parse-count-*"));
+
+	const Atom* where[3] = {nullptr, this, _outgoing[1].get()};
+	if (_nargs < _outgoing.size())
+		where[0] = _outgoing[_nargs].get();
+
+	for (const Atom* atom : where)
+	{
+		if (nullptr == atom) continue;
+		ValuePtr vp = atom->getValue(key_key);
+		if (vp and vp->is_atom()) return HandleCast(vp);
+	}
+	return default_key;
+}
+
+/// Options are doubles; LG wants ints. Anything too big for an int
+/// is taken to be as big as can be.
+static int to_int(double val)
+{
+	if (val >= (double) INT_MAX) return INT_MAX;
+	if (val <= (double) INT_MIN) return INT_MIN;
+	return (int) val;
+}
+
+/// Gather up the parse options. See the list of keys at the top of
+/// this file.
+LgParseSettings LGParseLink::get_settings() const
+{
+	static const Handle threads_key(createNode(PREDICATE_NODE, "*-lg-parse-threads-*"));
+	static const Handle lthreads_key(createNode(PREDICATE_NODE, "*-lg-linkage-threads-*"));
+	static const Handle time_key(createNode(PREDICATE_NODE, "*-lg-max-parse-time-*"));
+	static const Handle limit_key(createNode(PREDICATE_NODE, "*-lg-linkage-limit-*"));
+	static const Handle nulls_key(createNode(PREDICATE_NODE, "*-lg-null-count-*"));
+	static const Handle cost_key(createNode(PREDICATE_NODE, "*-lg-disjunct-cost-*"));
+	static const Handle short_key(createNode(PREDICATE_NODE, "*-lg-short-length-*"));
+	static const Handle spell_key(createNode(PREDICATE_NODE, "*-lg-spell-guess-*"));
+	static const Handle lazy_key(createNode(PREDICATE_NODE, "*-lg-lazy-*"));
+
+	// Pooled parse options get re-used; every setting that any user
+	// might change has to be set on every use. So start with the LG
+	// defaults, and not with "leave it alone".
+	static const LgParseSettings lg_defaults = []()
+	{
+		LgParseSettings dflt;
+		Parse_Options opts = parse_options_create();
+		dflt.disjunct_cost = parse_options_get_disjunct_cost(opts);
+		dflt.short_length = parse_options_get_short_length(opts);
+		dflt.spell_guess = parse_options_get_spell_guess(opts);
+		parse_options_delete(opts);
+		return dflt;
+	}();
+
+	LgParseSettings ps = lg_defaults;
 
 	// The number of linkages to process.
-	int max_linkages = 0;
-	if (3 <= _outgoing.size())
+	if (3 <= _nargs)
 	{
 		NumberNodePtr nnp(NumberNodeCast(_outgoing[2]));
-		max_linkages = nnp->get_value() + 0.5;
+		ps.max_linkages = to_int(nnp->get_value() + 0.5);
+	}
 
-		if (DEFAULT_NUM_LINKAGES < max_linkages)
-			parse_options_set_linkage_limit(opts, max_linkages);
+	std::vector<double> val;
+	if (get_option(threads_key, val) and 1.0 <= val[0])
+		ps.num_threads = val[0];
+	else
+	{
+		size_t ncpus = std::thread::hardware_concurrency();
+		ps.num_threads = (0 < ncpus) ? ncpus : 1;
 	}
 
-	// XXX FIXME -- We should fish parse options out of the atomspace.
-	// Something like this, maybe:
-	//     EvaluationLink
-	//         PredicateNode "LG ParseTime"
-	//         ListLink
-	//             LgDictNode "en"
-	//             NumberNode 42
-	// ... or something like that ... or maybe Values on the DictNode?
+	// Linkages are converted on the calling thread, unless more
+	// threads are asked for. Spreading a few linkages over many
+	// threads costs more than it saves.
+	if (get_option(lthreads_key, val) and 1.0 <= val[0])
+		ps.linkage_threads = val[0];
+	else
+		ps.linkage_threads = 1;
 
-	// Avoid generating big piles of Atoms, if the user did not
-	// want them. (The extra Atoms describe disjuncts, etc.)
-	bool djonly = (get_type() == LG_PARSE_DISJUNCTS);
-	bool sectonly = (get_type() == LG_PARSE_SECTIONS);
-	bool bondonly = (get_type() == LG_PARSE_BONDS);
-	bool everything = (get_type() == LG_PARSE_LINK);
+	if (get_option(time_key, val) and 0.0 < val[0])
+		ps.max_parse_time = val[0];
+
+	if (get_option(limit_key, val) and 1.0 <= val[0])
+		ps.linkage_limit = to_int(val[0]);
+
+	if (get_option(nulls_key, val) and 2 <= val.size() and
+	    0.0 <= val[0] and val[0] <= val[1])
+	{
+		ps.min_null_count = to_int(val[0]);
+		ps.max_null_count = to_int(val[1]);
+	}
+
+	if (get_option(cost_key, val))
+		ps.disjunct_cost = val[0];
+
+	if (get_option(short_key, val) and 1.0 <= val[0])
+		ps.short_length = to_int(val[0]);
+
+	if (get_option(spell_key, val) and 0.0 <= val[0])
+		ps.spell_guess = to_int(val[0]);
+
+	if (get_option(lazy_key, val))
+		ps.lazy = (0.0 != val[0]);
+
+	// Compact results hold no Atoms; there is nothing to defer.
+	if (LG_PARSE_COMPACT == get_type())
+		ps.lazy = false;
+
+	// Counts are summed as soon as the parse is done; no lazy.
+	if (LG_PARSE_COUNTS == get_type())
+	{
+		ps.lazy = false;
+		ps.count_key = get_count_key();
+	}
+
+	return ps;
+}
+
+/// Parse a batch of sentences. The sentences are handed out to a
+/// pool of worker threads, one sentence at a time, and parsed
+/// concurrently. The Link Grammar Dictionary is safe to share across
+/// threads; each thread creates its own Sentence and Parse_Options.
+///
+/// Returns a LinkValue holding one result per input, in input order.
+/// End-of-file markers in the input produce a VoidValue in the
+/// corresponding slot. A sentence that fails to parse (e.g. because
+/// it timed out) produces a result with no linkages in it, as made by
+/// no_parses(); the failure is logged, but does not abort the rest of
+/// the batch.
+ValuePtr LGParseLink::parse_batch(const ValueSeq& vlist,
+                                  const LgDictionaryPtr& dict,
+                                  const LgParseSettings& settings,
+                                  AtomSpace* as) const
+{
+	size_t nsent = vlist.size();
+
+	// Unpack everything up front, so that bad input is reported
+	// before any work gets done.
+	std::vector<std::string> phrases(nsent);
+	std::vector<bool> is_eof(nsent);
+	for (size_t i=0; i<nsent; i++)
+		is_eof[i] = not get_phrase(vlist[i], phrases[i]);
+
+	// Whatever threads are left over go to the linkages, if more
+	// than one was asked for.
+	size_t nthreads = std::min(settings.num_threads, nsent);
+	LgParseSettings ps(settings);
+	ps.linkage_threads = std::max<size_t>(1,
+		std::min(settings.linkage_threads, settings.num_threads / nsent));
+
+	// Every sentence is worth a thread of its own.
+	ValueSeq results(nsent);
+	lg_parallel_for(nsent, nthreads, 1, [&](size_t i, size_t)
+	{
+		if (is_eof[i])
+		{
+			results[i] = createVoidValue();
+			return;
+		}
+
+		try
+		{
+			results[i] = parse_phrase(phrases[i].c_str(), dict, ps, as);
+		}
+		catch (const std::exception& ex)
+		{
+			logger().warn("%s", ex.what());
+			results[i] = no_parses(ps, as);
+		}
+	});
+
+	return createLinkValue(results);
+}
+
+/// Parse a single sentence, returning a LinkValue holding the
+/// requested number of linkages.
+ValuePtr LGParseLink::parse_phrase(const char* phrstr,
+                                   const LgDictionaryPtr& dict,
+                                   const LgParseSettings& settings,
+                                   AtomSpace* as) const
+{
+	// Repeated sentences are served out of the cache, if it is on.
+	LGParseCache& cache = lg_parse_cache();
+	bool use_cache = cache.enabled() and is_cacheable();
+	std::string ckey;
+	if (use_cache)
+	{
+		ckey = cache_key(phrstr, dict, settings, as);
+		ValuePtr cached(cache.lookup(ckey, as));
+		if (cached) return cached;
+	}
+
+	Sentence sent = sentence_create(phrstr, dict->get());
+	if (nullptr == sent)
+		throw FatalErrorException(TRACE_INFO,
+			"LGParseLink: Unexpected parser failure!");
+
+	// Parse options come out of a pool kept by the dictionary node;
+	// they are already set up to be quiet, and to sample randomly.
+	// Everything else gets set here, on every use.
+	LgDictNodePtr ldn(LgDictNodeCast(_outgoing[1]));
+	Parse_Options opts = ldn->checkout_parse_options();
+
+	// Link Grammar counts parse time in whole seconds.
+	parse_options_set_max_parse_time(opts,
+		to_int(std::ceil(settings.max_parse_time)));
+
+	// Never consider fewer linkages than were asked for.
+	int max_linkages = settings.max_linkages;
+	parse_options_set_linkage_limit(opts,
+		std::max(settings.linkage_limit, max_linkages));
+
+	parse_options_set_disjunct_cost(opts, settings.disjunct_cost);
+	parse_options_set_short_length(opts, settings.short_length);
+	parse_options_set_spell_guess(opts, settings.spell_guess);
+
+	// LG clamps the max null count to the sentence length by itself.
+	bool retry_nulls = (settings.max_null_count < 0);
+	if (not retry_nulls)
+	{
+		parse_options_set_min_null_count(opts, settings.min_null_count);
+		parse_options_set_max_null_count(opts, settings.max_null_count);
+	}
 
 	// Count the number of parses.
 	int num_linkages = sentence_parse(sent, opts);
 	if (num_linkages < 0)
 	{
 		sentence_delete(sent);
-		parse_options_delete(opts);
+		ldn->return_parse_options(opts);
 		lg_error_flush();
 		lg_error_clearall();
 
@@ -365,13 +682,14 @@ ValuePtr LGParseLink::execute(AtomSpace* as, bool silent)
 		//   (LgParseBonds (Phrase "\n\n\n\n\n") (LgDict "any") (Number 4))
 		// LG sentence_split() returned non-zero value.
 		// In this case, there really are no parses.
-
-		return createLinkValue();
+		return no_parses(settings, as);
 	}
 
 	// If num_links is zero, try again, allowing null linked words.
-	// But only if there were really zero, and not a timeout.
-	if (num_linkages == 0 and not parse_options_resources_exhausted(opts))
+	// But only if there were really zero, and not a timeout, and
+	// the user did not ask for some specific null count.
+	if (num_linkages == 0 and retry_nulls and
+	    not parse_options_resources_exhausted(opts))
 	{
 		parse_options_reset_resources(opts);
 		parse_options_set_min_null_count(opts, 1);
@@ -382,7 +700,7 @@ ValuePtr LGParseLink::execute(AtomSpace* as, bool silent)
 	if (num_linkages <= 0)
 	{
 		sentence_delete(sent);
-		parse_options_delete(opts);
+		ldn->return_parse_options(opts);
 		lg_error_flush();
 		lg_error_clearall();
 		throw RuntimeException(TRACE_INFO,
@@ -400,55 +718,353 @@ ValuePtr LGParseLink::execute(AtomSpace* as, bool silent)
 	// There are only so many parses available.
 	int num_available = sentence_num_linkages_post_processed(sent);
 
-	ValueSeq vlist;
-	int jct = 0;
-	for (int i=0; jct<num_linkages and i<num_available; i++)
+	// Pick out the linkages to return; skip those with P.P.
+	// violations. They are created only when they are converted.
+	std::vector<int> picks;
+	for (int i=0; (int) picks.size()<num_linkages and i<num_available; i++)
 	{
-		// Skip sentences with P.P. violations.
 		if (0 < sentence_num_violations(sent, i)) continue;
-		jct ++;
-		Linkage lkg = linkage_create(i, sent, opts);
+		picks.push_back(i);
+	}
+
+	// Lazy results hold on to the Sentence; linkages are created and
+	// converted only when they are looked at. These are never cached.
+	if (settings.lazy)
+	{
+		auto psent = std::make_shared<LGParsedSentence>(
+			LGParseLinkCast(get_handle()), ldn, dict,
+			AtomSpaceCast(as->get_handle()), phrstr,
+			sent, opts, std::move(picks));
+		lg_error_flush();
+		lg_error_clearall();
+
+		ValueSeq lazy;
+		for (size_t i=0; i<psent->size(); i++)
+			lazy.emplace_back(createLGLinkageValue(psent, i));
+		return createLinkValue(lazy);
+	}
 
-		// Provide the requested info.
-		if (sectonly)
+	// Linkages are created a batch at a time, converted, and deleted,
+	// so that only so many of them are held at once, however many
+	// were asked for. Linkage creation is not thread-safe: it fills
+	// in per-sentence state on first use. So each batch is created
+	// here, in order, and only then converted to Atoms, possibly in
+	// parallel.
+	static const size_t LINKAGE_BATCH = 1024;
+
+	ValueSeq vlist;
+	LgCompactTables tables;
+	std::vector<Linkage> lkgs;
+	try
+	{
+		for (size_t start=0; start<picks.size(); start += LINKAGE_BATCH)
 		{
-			ValuePtr sects(make_sects(lkg, phrstr, as));
-			ValuePtr bonds(make_bonds(lkg, phrstr, as));
-			vlist.emplace_back(createLinkValue(ValueSeq({sects, bonds})));
+			size_t end = std::min(picks.size(), start + LINKAGE_BATCH);
+			for (size_t i=start; i<end; i++)
+				lkgs.push_back(linkage_create(picks[i], sent, opts));
+
+			ValueSeq part;
+			if (LG_PARSE_COMPACT == get_type())
+				part = make_compact(lkgs, phrstr, tables);
+			else
+				part = make_linkages(lkgs, phrstr, settings, as);
+			vlist.insert(vlist.end(), part.begin(), part.end());
+
+			for (Linkage lkg : lkgs)
+				linkage_delete(lkg);
+			lkgs.clear();
 		}
-		else if (bondonly)
+	}
+	catch (...)
+	{
+		for (Linkage lkg : lkgs)
+			linkage_delete(lkg);
+		sentence_delete(sent);
+		ldn->return_parse_options(opts);
+		lg_error_flush();
+		lg_error_clearall();
+		throw;
+	}
+
+	// The compact tables go in front of the linkages.
+	if (LG_PARSE_COMPACT == get_type())
+		vlist.insert(vlist.begin(), {
+			createStringValue(std::move(tables.words)),
+			createStringValue(std::move(tables.labels)),
+			createStringValue(std::move(tables.djs))});
+
+	// If LG found more linkages than the limit, then it handed back
+	// a random sample of them. If it ran out of time, it handed back
+	// whatever it found by then. Don't cache either.
+	int linkage_limit = parse_options_get_linkage_limit(opts);
+	if (linkage_limit < sentence_num_linkages_found(sent) or
+	    parse_options_resources_exhausted(opts))
+		use_cache = false;
+
+	sentence_delete(sent);
+	ldn->return_parse_options(opts);
+	lg_error_flush();
+	lg_error_clearall();
+
+	// LgParseCounts hands back only the summary.
+	if (LG_PARSE_COUNTS == get_type())
+		return count_linkages(vlist, settings.count_key, as);
+
+	// Return a LinkValue holding all of the disjuncts
+	ValuePtr result(createLinkValue(vlist));
+	if (use_cache)
+		cache.insert(ckey, result, AtomSpaceCast(as->get_handle()));
+	return result;
+}
+
+/// The result of a sentence without any parses: the same layout as
+/// usual, with no linkages in it.
+ValuePtr LGParseLink::no_parses(const LgParseSettings& settings,
+                                AtomSpace* as) const
+{
+	if (LG_PARSE_COUNTS == get_type())
+		return count_linkages(ValueSeq(), settings.count_key, as);
+
+	// The compact string tables, all empty.
+	if (LG_PARSE_COMPACT == get_type())
+		return createLinkValue(ValueSeq({
+			createStringValue(std::vector<std::string>()),
+			createStringValue(std::vector<std::string>()),
+			createStringValue(std::vector<std::string>())}));
+
+	return createLinkValue();
+}
+
+/// Parse results can be cached, unless they are meant to be random,
+/// or the dictionary is subject to change. The "any" language is
+/// used for random sampling; different results are wanted every time.
+/// AtomSpace-backed dictionaries change as they are being learned.
+bool LGParseLink::is_cacheable() const
+{
+	// Counting has side effects; every parse must be counted.
+	if (LG_PARSE_COUNTS == get_type()) return false;
+	if (4 <= _nargs) return false;
+	if (0 == _outgoing[1]->get_name().compare("any")) return false;
+	return true;
+}
+
+/// Everything that can change the result of a parse has to be in the
+/// cache key. The AtomSpace is in there, because the results hold
+/// Atoms that live in it; its address tells apart the AtomSpaces
+/// that are alive now, and the cache itself checks that the one that
+/// an entry was made in is still alive. The dictionary serial number
+/// is in there, so that a reloaded or evicted dictionary is never
+/// served the parses made with the old copy.
+std::string LGParseLink::cache_key(const char* phrstr,
+                                   const LgDictionaryPtr& dict,
+                                   const LgParseSettings& ps,
+                                   AtomSpace* as) const
+{
+	char buf[256];
+	snprintf(buf, sizeof(buf), "%d:%d:%d:%g:%d:%d:%g:%d:%d:%p:%zu:",
+		(int) get_type(), ps.max_linkages, ps.linkage_limit,
+		ps.max_parse_time, ps.min_null_count, ps.max_null_count,
+		ps.disjunct_cost, ps.short_length, ps.spell_guess, (void*) as,
+		dict->serial());
+
+	std::string key(buf);
+	key += _outgoing[1]->get_name();
+	key += '\n';
+	key += phrstr;
+	return key;
+}
+
+/// Convert linkages to Atoms. Linkages are handed out to the linkage
+/// threads in chunks; each thread interns its own words and
+/// connectors. The results are in the same order as the linkages.
+ValueSeq LGParseLink::make_linkages(const std::vector<Linkage>& lkgs,
+                                    const char* phrstr,
+                                    const LgParseSettings& settings,
+                                    AtomSpace* as) const
+{
+	// Small chunks keep the threads evenly loaded; not so small that
+	// each thread has to re-intern everything over and over.
+	static const size_t CHUNK = 16;
+
+	size_t nlkgs = lkgs.size();
+	size_t nchunks = (nlkgs + CHUNK - 1) / CHUNK;
+	size_t nthreads = std::max<size_t>(1,
+		std::min(settings.linkage_threads, nchunks));
+
+	// All of the linkages share the same words and connectors; each
+	// thread keeps its own interner for them.
+	ValueSeq vlist(nlkgs);
+	std::vector<std::unique_ptr<LGParseInterner>> interns(nthreads);
+	lg_parallel_for(nchunks, nthreads, 1, [&](size_t c, size_t t)
+	{
+		if (nullptr == interns[t])
+			interns[t].reset(new LGParseInterner(as, phrstr));
+
+		size_t end = std::min(nlkgs, (c+1) * CHUNK);
+		for (size_t i = c * CHUNK; i < end; i++)
+			vlist[i] = make_linkage(lkgs[i], *interns[t]);
+	});
+	return vlist;
+}
+
+/// Find the id of `str` in `tab`, adding it if it is not there.
+static double compact_id(std::unordered_map<std::string, double>& ids,
+                         std::vector<std::string>& tab,
+                         std::string&& str)
+{
+	auto it = ids.find(str);
+	if (ids.end() != it) return it->second;
+	double id = tab.size();
+	ids.emplace(str, id);
+	tab.emplace_back(std::move(str));
+	return id;
+}
+
+/// Encode linkages as numbers, without creating any Atoms. The
+/// result of LgParseCompact is a sequence of
+///     StringValue  -- the words, each word once
+///     StringValue  -- the link labels, each label once
+///     StringValue  -- the disjuncts, each disjunct once
+/// followed by one LinkValue per linkage, holding three FloatValues:
+///     word ids, one per word of the linkage, indexing the words;
+///     (lword, rword, label id) triples, one per link; the lword and
+///         rword are positions in the linkage, not word ids;
+///     disjunct ids, one per word of the linkage; -1 if none.
+/// This returns the LinkValues for the given linkages. The strings
+/// are added to `tabs`, which is shared by all of the linkages of
+/// the sentence.
+ValueSeq LGParseLink::make_compact(const std::vector<Linkage>& lkgs,
+                                   const char* phrstr,
+                                   LgCompactTables& tabs) const
+{
+	ValueSeq encoded;
+	for (Linkage lkg : lkgs)
+	{
+		int nwords = linkage_get_num_words(lkg);
+		std::vector<double> wids, dids;
+		wids.reserve(nwords);
+		dids.reserve(nwords);
+		for (int w=0; w<nwords; w++)
 		{
-			ValuePtr words(make_words(lkg, phrstr, as));
-			ValuePtr bonds(make_bonds(lkg, phrstr, as));
-			vlist.emplace_back(createLinkValue(ValueSeq({words, bonds})));
+			// As in LGParseInterner, words are keyed by byte span.
+			size_t sb = linkage_get_word_byte_start(lkg, w);
+			size_t eb = linkage_get_word_byte_end(lkg, w);
+			if (eb != sb)
+			{
+				uint64_t key = (((uint64_t) sb) << 32) | (uint64_t) eb;
+				auto it = tabs.spans.find(key);
+				if (tabs.spans.end() == it)
+				{
+					it = tabs.spans.emplace(key, (double) tabs.words.size()).first;
+					tabs.words.emplace_back(phrstr + sb, eb - sb);
+				}
+				wids.push_back(it->second);
+			}
+			else
+				wids.push_back(compact_id(tabs.named, tabs.words,
+					LGParseInterner::word_string(lkg, w, phrstr)));
+
+			const char* djstr = linkage_get_disjunct_str(lkg, w);
+			if (nullptr == djstr or 0 == *djstr)
+				dids.push_back(-1.0);
+			else
+				dids.push_back(compact_id(tabs.dj_ids, tabs.djs, djstr));
 		}
-		else if (djonly)
+
+		int nlinks = linkage_get_num_links(lkg);
+		std::vector<double> links;
+		links.reserve(3 * nlinks);
+		for (int lk=0; lk<nlinks; lk++)
 		{
-			vlist.emplace_back(make_djs(lkg, phrstr, as));
+			links.push_back(linkage_get_link_lword(lkg, lk));
+			links.push_back(linkage_get_link_rword(lkg, lk));
+			links.push_back(compact_id(tabs.label_ids, tabs.labels,
+				linkage_get_link_label(lkg, lk)));
 		}
-		else if (everything)
+
+		encoded.emplace_back(createLinkValue(ValueSeq({
+			createFloatValue(std::move(wids)),
+			createFloatValue(std::move(links)),
+			createFloatValue(std::move(dids))})));
+	}
+	return encoded;
+}
+
+/// Add one to the count on every bond, disjunct and Section of every
+/// linkage; the linkages are as made by make_linkage(). The counts
+/// are FloatValues at `key`; the AtomSpace increments them atomically,
+/// so that concurrent parses can count into the same Atoms. Returns
+/// a FloatValue holding the number of linkages, bonds, disjuncts and
+/// Sections that were counted.
+ValuePtr LGParseLink::count_linkages(const ValueSeq& vlist,
+                                     const Handle& key,
+                                     AtomSpace* as) const
+{
+	static const std::vector<double> one({1.0});
+
+	std::vector<double> summary({(double) vlist.size(), 0.0, 0.0, 0.0});
+	for (const ValuePtr& lkg : vlist)
+	{
+		// Skip the words; count the rest.
+		const ValueSeq& parts = LinkValueCast(lkg)->value();
+		for (size_t i=1; i<parts.size(); i++)
 		{
-			ValuePtr words(make_words(lkg, phrstr, as));
-			ValuePtr bonds(make_bonds(lkg, phrstr, as));
-			ValuePtr disjs(make_djs(lkg, phrstr, as));
-			ValuePtr sects(make_sects(lkg, phrstr, as));
-			vlist.emplace_back(createLinkValue(ValueSeq({words, bonds, disjs, sects})));
+			const ValueSeq& atoms = LinkValueCast(parts[i])->value();
+			for (const ValuePtr& vp : atoms)
+				as->increment_count(HandleCast(vp), key, one);
+			summary[i] += atoms.size();
 		}
-		linkage_delete(lkg);
 	}
+	return createFloatValue(summary);
+}
 
-	sentence_delete(sent);
-	parse_options_delete(opts);
-	lg_error_flush();
-	lg_error_clearall();
+/// The WordNode for word `w`, looked up the first time that it is
+/// needed, and kept in `words` after that.
+static const Handle& get_word(Linkage lkg, int w, HandleSeq& words,
+                              LGParseInterner& intern)
+{
+	Handle& h = words[w];
+	if (nullptr == h) h = intern.word(lkg, w);
+	return h;
+}
 
-	// Return a LinkValue holding all of the disjuncts
-	return createLinkValue(vlist);
+/// Provide the requested info about one linkage. This is a single
+/// pass over the linkage: each WordNode is looked up once, and then
+/// shared by all of the builders that need it.
+ValuePtr LGParseLink::make_linkage(Linkage lkg,
+                                   LGParseInterner& intern) const
+{
+	// Avoid generating big piles of Atoms, if the user did not
+	// want them. (The extra Atoms describe disjuncts, etc.)
+	// Only LgParseLink and LgParseBonds list all of the words. The
+	// others make WordNodes only for the words that have links; the
+	// null-linked words are left out.
+	Type t = get_type();
+	HandleSeq words;
+	if (LG_PARSE_DISJUNCTS == t or LG_PARSE_SECTIONS == t)
+		words.resize(linkage_get_num_words(lkg));
+	else
+		words = intern.words(lkg);
+
+	if (LG_PARSE_DISJUNCTS == t)
+		return make_djs(lkg, words, intern);
+
+	ValuePtr bonds(make_bonds(lkg, words, intern));
+
+	if (LG_PARSE_SECTIONS == t)
+		return createLinkValue(ValueSeq({make_sects(lkg, words, intern), bonds}));
+
+	if (LG_PARSE_BONDS == t)
+		return createLinkValue(ValueSeq({createLinkValue(words), bonds}));
+
+	ValuePtr disjs(make_djs(lkg, words, intern));
+	ValuePtr sects(make_sects(lkg, words, intern));
+	return createLinkValue(ValueSeq({createLinkValue(words), bonds, disjs, sects}));
 }
 
 // Create only the disjuncts for the parse, and nothing else.
-ValuePtr LGParseLink::make_djs(Linkage lkg, const char* phrstr,
-                               AtomSpace* as) const
+ValuePtr LGParseLink::make_djs(Linkage lkg, HandleSeq& words,
+                               LGParseInterner& intern) const
 {
 	HandleSeq djs;
 
@@ -456,15 +1072,12 @@ ValuePtr LGParseLink::make_djs(Linkage lkg, const char* phrstr,
 	int nwords = linkage_get_num_words(lkg);
 	for (int w=0; w<nwords; w++)
 	{
-		HandleSeq conseq = make_lg_conseq(lkg, w, as);
+		HandleSeq conseq = intern.lg_conseq(lkg, w);
 		if (0 == conseq.size()) continue;
 
-		std::string wrd = get_word_string(lkg, w, phrstr);
-
 		// Set up the disjuncts on each word
-		Handle dj = as->add_link(LG_DISJUNCT,
-			as->add_node(WORD_NODE, std::move(wrd)),
-			as->add_link(CONNECTOR_SEQ, std::move(conseq)));
+		Handle dj = intern.link(LG_DISJUNCT, get_word(lkg, w, words, intern),
+			intern.link(CONNECTOR_SEQ, std::move(conseq)));
 
 		djs.emplace_back(dj);
 	}
@@ -474,24 +1087,23 @@ ValuePtr LGParseLink::make_djs(Linkage lkg, const char* phrstr,
 // Create only the Sections for the parse, and nothing else.
 // Sections are almost exactly like Disjuncts, but have a
 // different format.
-ValuePtr LGParseLink::make_sects(Linkage lkg, const char* phrstr,
-                                 AtomSpace* as) const
+ValuePtr LGParseLink::make_sects(Linkage lkg, HandleSeq& words,
+                                 LGParseInterner& intern) const
 {
 	HandleSeq djs;
 
+	LgLinkageAdjacency adj(lkg);
+
 	// Loop over all the words.
 	int nwords = linkage_get_num_words(lkg);
 	for (int w=0; w<nwords; w++)
 	{
-		HandleSeq conseq = make_conseq(lkg, w, phrstr, as);
+		HandleSeq conseq = make_conseq(lkg, adj, w, words, intern);
 		if (0 == conseq.size()) continue;
 
-		std::string wrd = get_word_string(lkg, w, phrstr);
-
 		// Set up the disjuncts on each word
-		Handle dj = as->add_link(SECTION,
-			as->add_node(WORD_NODE, std::move(wrd)),
-			as->add_link(CONNECTOR_SEQ, std::move(conseq)));
+		Handle dj = intern.link(SECTION, get_word(lkg, w, words, intern),
+			intern.link(CONNECTOR_SEQ, std::move(conseq)));
 
 		djs.emplace_back(dj);
 	}
@@ -501,8 +1113,8 @@ ValuePtr LGParseLink::make_sects(Linkage lkg, const char* phrstr,
 
 // Create only the EdgeLink-BondNodes for the parse.
 // These are just the links in the linkage.
-ValuePtr LGParseLink::make_bonds(Linkage lkg, const char* phrstr,
-                                 AtomSpace* as) const
+ValuePtr LGParseLink::make_bonds(Linkage lkg, HandleSeq& words,
+                                 LGParseInterner& intern) const
 {
 	HandleSeq bonds;
 
@@ -514,149 +1126,85 @@ ValuePtr LGParseLink::make_bonds(Linkage lkg, const char* phrstr,
 		int rword = linkage_get_link_rword(lkg, lk);
 
 		// Get the words at either end.
-		Handle lst(as->add_link(LIST_LINK,
-			as->add_node(WORD_NODE, get_word_string(lkg, lword, phrstr)),
-			as->add_node(WORD_NODE, get_word_string(lkg, rword, phrstr))));
+		Handle lst(intern.link(LIST_LINK,
+			get_word(lkg, lword, words, intern),
+			get_word(lkg, rword, words, intern)));
 
 		// The bond type.
 		const char* label = linkage_get_link_label(lkg, lk);
-		Handle brel(as->add_node(BOND_NODE, label));
+		Handle brel(intern.bond(label));
 
-		Handle bond(as->add_link(EDGE_LINK, brel, lst));
+		Handle bond(intern.link(EDGE_LINK, brel, lst));
 		bonds.emplace_back(bond);
 	}
 	return createLinkValue(bonds);
 }
 
-ValuePtr LGParseLink::make_words(Linkage lkg, const char* phrstr,
-                                 AtomSpace* as) const
-{
-	// Loop over all the words.
-	HandleSeq words;
-	int nwords = linkage_get_num_words(lkg);
-	for (int w=0; w<nwords; w++)
-	{
-		// Get the word in the sentence.
-		std::string wrd = get_word_string(lkg, w, phrstr);
-		Handle word(as->add_node(WORD_NODE, std::move(wrd)));
-		words.emplace_back(word);
-	}
-	return createLinkValue(words);
-}
-
-/// Convert the disjunct to LG-style Atomese, using LgConn and LgConDir.
-HandleSeq LGParseLink::make_lg_conseq(Linkage lkg, int w, AtomSpace* as) const
-{
-	// This requires parsing a string. Fortunately, the
-	// string is a very simple format.
-	const char* djstr = linkage_get_disjunct_str(lkg, w);
-
-	HandleSeq conseq;
-	const char* p = djstr;
-	while (*p)
-	{
-		while (' ' == *p) p++;
-		if (0 == *p) break;
-		bool multi = false;
-		if ('@' == *p) { multi = true; p++; }
-		const char* s = strchr(p, ' ');
-		size_t len = s-p-1;
-		if (NULL == s) len = strlen(p) - 1;
-		char cstr[60];
-		if (60 <= len)
-			throw RuntimeException(TRACE_INFO,
-				"LGParseLink: Dictionary has a bug; Unexpectedly long connector=%s", djstr);
-		strncpy(cstr, p, len);
-		cstr[len] = 0;
-		Handle con(as->add_node(LG_CONN_NODE, cstr));
-		cstr[0] = *(p+len);
-		cstr[1] = 0;
-		Handle dir(as->add_node(LG_CONN_DIR_NODE, cstr));
-		p = p+len+1;
-
-		HandleSeq cono;
-		cono.push_back(con);
-		cono.push_back(dir);
-		if (multi)
-		{
-			Handle mu(as->add_node(LG_CONN_MULTI_NODE, "@"));
-			cono.push_back(mu);
-		}
-		Handle conl(as->add_link(LG_CONNECTOR, std::move(cono)));
-		conseq.push_back(conl);
-	}
-
-	return conseq;
-}
-
 /// Convert the disjunct to Section-style Atomese, using ConnectorLink
-/// and ConnectorDir. Similar to `make_lg_conseq` except that this uses
-/// the generic connector style, and uses words, not link types, for the
-/// connectors.
-HandleSeq LGParseLink::make_conseq(Linkage lkg, int w,
-                                   const char* phrstr,
-                                   AtomSpace* as) const
+/// and ConnectorDir. Similar to `LGParseInterner::lg_conseq` except
+/// that this uses the generic connector style, and uses words, not
+/// link types, for the connectors.
+HandleSeq LGParseLink::make_conseq(Linkage lkg,
+                                   const LgLinkageAdjacency& adj, int w,
+                                   HandleSeq& words,
+                                   LGParseInterner& intern) const
 {
-	std::vector<int> lks;
-
-	// Loop over all links, find the ones which connect to this word.
-	size_t nlinks = linkage_get_num_links(lkg);
-	for (size_t li=0; li < nlinks; li++)
-	{
-		// Look for links attaching to this word.
-		int lw = (int) linkage_get_link_lword(lkg, li);
-		int rw = (int) linkage_get_link_rword(lkg, li);
-
-		if (lw == w) lks.push_back(rw);
-		else if (rw == w) lks.push_back(lw);
-	}
-
-	// Place them in ascending order.
-	std::sort(lks.begin(), lks.end());
+	// The links attached to this word, already in ascending order.
+	int first = adj.start[w];
+	int last = adj.start[w+1];
 
 	// Create a connector seq from the sorted links
 	HandleSeq conseq;
-	for (int c : lks)
+	conseq.reserve(last - first);
+	for (int i = first; i < last; i++)
 	{
-		std::string wrd = get_word_string(lkg, c, phrstr);
-		Handle con(as->add_node(WORD_NODE, std::move(wrd)));
-		Handle dir(as->add_node(SEX_NODE, c<w ? "-" : "+"));
-		Handle conl(as->add_link(CONNECTOR, con, dir));
-		conseq.push_back(conl);
+		int c = adj.nbrs[i];
+		conseq.push_back(intern.connector(get_word(lkg, c, words, intern), c<w));
 	}
 
 	return conseq;
 }
 
-std::string LGParseLink::get_word_string(Linkage lkg, int w,
-                                         const char* phrstr) const
+/// Build the word adjacency lists for a linkage. Each link is
+/// entered twice, once for each end. A counting sort on the far end,
+/// followed by a stable scatter on the near end, leaves every row
+/// sorted, without any per-word sort.
+LgLinkageAdjacency::LgLinkageAdjacency(Linkage lkg)
 {
-	size_t sb = linkage_get_word_byte_start(lkg, w);
-	size_t eb = linkage_get_word_byte_end(lkg, w);
+	int nwords = linkage_get_num_words(lkg);
+	int nlinks = linkage_get_num_links(lkg);
 
-	// Problem: the default LG API supplies the word together with
-	// the subscript, and with word regex and guess-marks. We really
-	// do NOT want that crud. So use the byte offsets to get the
-	// actual original string.  Since LEFT-WALL and RIGHT-WALL have
-	// no offsets, we need to handle those differently.
-	if (eb != sb) // Neither are equal to -1
+	std::vector<int> lw(nlinks), rw(nlinks);
+	std::vector<int> deg(nwords+1, 0);
+	for (int li=0; li < nlinks; li++)
 	{
-		std::string rv(phrstr + sb, eb - sb);
-		return rv;
+		lw[li] = linkage_get_link_lword(lkg, li);
+		rw[li] = linkage_get_link_rword(lkg, li);
+		deg[lw[li]+1] ++;
+		deg[rw[li]+1] ++;
+	}
+	for (int w=0; w < nwords; w++)
+		deg[w+1] += deg[w];
+
+	// Pass one: list each link-end as (row, col), ordered by col.
+	// The degree of a word is the same whichever end is counted,
+	// so the same offsets serve for both passes.
+	std::vector<int> row(2*nlinks), col(2*nlinks);
+	std::vector<int> fill(deg.begin(), deg.end()-1);
+	for (int li=0; li < nlinks; li++)
+	{
+		int i = fill[rw[li]]++;
+		row[i] = lw[li]; col[i] = rw[li];
+		i = fill[lw[li]]++;
+		row[i] = rw[li]; col[i] = lw[li];
 	}
 
-	const char* wrd = linkage_get_word(lkg, w);
-
-	// LEFT-WALL is not an ordinary word. Its special. Make it
-	// extra-special by adding "illegal" punctuation to it.
-	if (0 == w and 0 == strcmp(wrd, "LEFT-WALL"))
-		return "###LEFT-WALL###";
-
-	int nwords = linkage_get_num_words(lkg);
-	if (nwords-1 == w and 0 == strcmp(wrd, "RIGHT-WALL"))
-		return "###RIGHT-WALL###";
-
-	return wrd;
+	// Pass two: scatter into rows; the col order is kept.
+	start = deg;
+	nbrs.resize(2*nlinks);
+	fill.assign(deg.begin(), deg.end()-1);
+	for (int i=0; i < 2*nlinks; i++)
+		nbrs[fill[row[i]]++] = col[i];
 }
 
 DEFINE_LINK_FACTORY(LGParseLink, LG_PARSE_LINK)
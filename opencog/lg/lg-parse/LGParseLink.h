@@ -24,13 +24,21 @@
 #ifndef _OPENCOG_LG_PARSE_H
 #define _OPENCOG_LG_PARSE_H
 
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include <link-grammar/link-includes.h>
 
 #include <opencog/atoms/core/FunctionLink.h>
+#include <opencog/lg/lg-dict/LGDictRegistry.h>
 #include <opencog/lg/types/atom_types.h>
 
 namespace opencog
 {
+class LGParseInterner;
+
 /** \addtogroup grp_atomspace
  *  @{
  */
@@ -41,18 +49,109 @@ namespace opencog
 /// LgParseBonds
 /// LgParseSections
 /// LgParseDisjuncts -- Return the disjuncts used in the parse.
+/// LgParseCounts -- Count the Sections, disjuncts and bonds.
+/// LgParseCompact -- Return the parse as numbers; no Atoms.
+///
+/// If the phrase argument evaluates to more than one sentence, then
+/// all of them are parsed concurrently, as a batch, and one result is
+/// returned per sentence, in the same order.
+
+/// Parse options, gathered from the AtomSpace.
+/// See LGParseLink::get_settings() for where they come from.
+struct LgParseSettings
+{
+	// Number of threads for batch parsing.
+	size_t num_threads = 1;
+
+	// Number of threads converting the linkages of one sentence
+	// into Atoms. Batches and streams already keep their threads
+	// busy, one sentence each, and lower this accordingly.
+	size_t linkage_threads = 1;
+
+	// Number of linkages to return; zero means all of them.
+	int max_linkages = 0;
+
+	// Timeout, in seconds; the LG default is infinite.
+	double max_parse_time = 150.0;
+
+	// For the MST/MPG parses, the disjuncts consist of all-optional
+	// connectors, and the number of parses generated is huge. If we
+	// expect to have a good chance of finding the linkage with the
+	// minimal cost, we have to look at a lot of them. This does
+	// impact performance; I don't know how much. Storage is about
+	// 120 bytes per linkage, so 15000 linkages == 2MBytes.
+	int linkage_limit = 15000;
+
+	// Range of null-linked words. A negative max means: first try
+	// with no nulls, and if that fails, allow any number of them.
+	int min_null_count = 0;
+	int max_null_count = -1;
+
+	// Pruning and spell-guessing.
+	double disjunct_cost = 0.0;
+	int short_length = 0;
+	int spell_guess = 0;
+
+	// Return lazy LGLinkageValues instead of converted linkages.
+	bool lazy = false;
+
+	// LgParseCounts only: the key at which counts are kept.
+	Handle count_key;
+};
+
+/// The links of a linkage, indexed by word. This is in compressed
+/// sparse row form: the words linked to word `w` are
+/// `nbrs[start[w]]` through `nbrs[start[w+1]-1]`, in ascending order.
+/// Built once per linkage, in time linear in the number of links.
+struct LgLinkageAdjacency
+{
+	std::vector<int> start;
+	std::vector<int> nbrs;
+
+	LgLinkageAdjacency(Linkage);
+};
+
+/// The string tables of an LgParseCompact result. They are filled in
+/// as the linkages of a sentence are encoded, a batch at a time.
+struct LgCompactTables
+{
+	std::vector<std::string> words;
+	std::vector<std::string> labels;
+	std::vector<std::string> djs;
+
+	// Ids of the words (by byte span, or by name for the walls), the
+	// link labels and the disjuncts.
+	std::unordered_map<uint64_t, double> spans;
+	std::unordered_map<std::string, double> named;
+	std::unordered_map<std::string, double> label_ids;
+	std::unordered_map<std::string, double> dj_ids;
+};
 
 class LGParseLink : public FunctionLink
 {
 protected:
+	// Number of arguments, not counting the options anchor.
+	size_t _nargs;
+
 	void init();
-	std::string get_word_string(Linkage, int, const char*) const;
-	HandleSeq make_lg_conseq(Linkage, int, AtomSpace*) const;
-	HandleSeq make_conseq(Linkage, int, const char*, AtomSpace*) const;
-	ValuePtr make_djs(Linkage, const char*, AtomSpace*) const;
-	ValuePtr make_sects(Linkage, const char*, AtomSpace*) const;
-	ValuePtr make_bonds(Linkage, const char*, AtomSpace*) const;
-	ValuePtr make_words(Linkage, const char*, AtomSpace*) const;
+	bool get_option(const Handle&, std::vector<double>&) const;
+	Handle get_count_key() const;
+	ValueSeq make_compact(const std::vector<Linkage>&, const char*,
+	                      LgCompactTables&) const;
+	ValuePtr count_linkages(const ValueSeq&, const Handle&,
+	                        AtomSpace*) const;
+	bool is_cacheable() const;
+	std::string cache_key(const char*, const LgDictionaryPtr&,
+	                      const LgParseSettings&, AtomSpace*) const;
+	ValuePtr parse_batch(const ValueSeq&, const LgDictionaryPtr&,
+	                     const LgParseSettings&, AtomSpace*) const;
+	ValueSeq make_linkages(const std::vector<Linkage>&, const char*,
+	                       const LgParseSettings&, AtomSpace*) const;
+	HandleSeq make_conseq(Linkage, const LgLinkageAdjacency&, int,
+	                      HandleSeq&, LGParseInterner&) const;
+	ValuePtr make_djs(Linkage, HandleSeq&, LGParseInterner&) const;
+	ValuePtr make_sects(Linkage, HandleSeq&, LGParseInterner&) const;
+	ValuePtr make_bonds(Linkage, HandleSeq&, LGParseInterner&) const;
 
 public:
 	LGParseLink(const HandleSeq&&, Type=LG_PARSE_LINK);
@@ -62,6 +161,16 @@ public:
 	// Return a pointer to the atom being specified.
 	virtual ValuePtr execute(AtomSpace*, bool);
 
+	// The pieces that execute() is made of; these are used by
+	// pipeline stages that drive the parser directly.
+	LgDictionaryPtr get_dictionary() const;
+	LgParseSettings get_settings() const;
+	static bool get_phrase(const ValuePtr&, std::string&);
+	ValuePtr parse_phrase(const char*, const LgDictionaryPtr&,
+	                      const LgParseSettings&, AtomSpace*) const;
+	ValuePtr make_linkage(Linkage, LGParseInterner&) const;
+	ValuePtr no_parses(const LgParseSettings&, AtomSpace*) const;
+
 	static Handle factory(const Handle&);
 };
 
@@ -89,6 +198,22 @@ public:
 	LGParseBonds& operator=(const LGParseBonds&) = delete;
 };
 
+class LGParseCompact : public LGParseLink
+{
+public:
+	LGParseCompact(const HandleSeq&&, Type=LG_PARSE_COMPACT);
+	LGParseCompact(const LGParseCompact&) = delete;
+	LGParseCompact& operator=(const LGParseCompact&) = delete;
+};
+
+class LGParseCounts : public LGParseLink
+{
+public:
+	LGParseCounts(const HandleSeq&&, Type=LG_PARSE_COUNTS);
+	LGParseCounts(const LGParseCounts&) = delete;
+	LGParseCounts& operator=(const LGParseCounts&) = delete;
+};
+
 LINK_PTR_DECL(LGParseLink)
 #define createLGParseLink CREATE_DECL(LGParseLink)
 
@@ -101,6 +226,12 @@ LINK_PTR_DECL(LGParseSections)
 LINK_PTR_DECL(LGParseBonds)
 #define createLGParseBonds CREATE_DECL(LGParseBonds)
 
+LINK_PTR_DECL(LGParseCompact)
+#define createLGParseCompact CREATE_DECL(LGParseCompact)
+
+LINK_PTR_DECL(LGParseCounts)
+#define createLGParseCounts CREATE_DECL(LGParseCounts)
+
 /** @}*/
 }
 #endif // _OPENCOG_LG_PARSE_H
@@ -0,0 +1,118 @@
+/*
+ * LGParseSCM.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/guile/SchemePrimitive.h>
+
+#include "LGParseCache.h"
+
+namespace opencog
+{
+class LGParseSCM
+{
+private:
+	static void* init_in_guile(void*);
+	static void init_in_module(void*);
+	void init(void);
+
+	void do_cache_config(int, double);
+	ValuePtr do_cache_stats(void);
+
+public:
+	LGParseSCM();
+};
+
+}
+
+using namespace opencog;
+
+/**
+ * The constructor for LGParseSCM.
+ */
+LGParseSCM::LGParseSCM()
+{
+	static bool is_init = false;
+	if (is_init) return;
+	is_init = true;
+	scm_with_guile(init_in_guile, this);
+}
+
+/**
+ * Init function for using with scm_with_guile.
+ *
+ * @param self   pointer to the LGParseSCM object
+ * @return       null
+ */
+void* LGParseSCM::init_in_guile(void* self)
+{
+	scm_c_define_module("opencog lg", init_in_module, self);
+	scm_c_use_module("opencog lg");
+	return NULL;
+}
+
+/**
+ * @param data   pointer to the LGParseSCM object
+ */
+void LGParseSCM::init_in_module(void* data)
+{
+	LGParseSCM* self = (LGParseSCM*) data;
+	self->init();
+}
+
+void LGParseSCM::init()
+{
+	define_scheme_primitive("lg-parse-cache-config",
+		 &LGParseSCM::do_cache_config, this, "lg");
+	define_scheme_primitive("lg-parse-cache-stats",
+		 &LGParseSCM::do_cache_stats, this, "lg");
+}
+
+/**
+ * Implementation of the "lg-parse-cache-config" scheme primitive.
+ *
+ * @param entries    maximum number of cached parses; zero disables.
+ * @param megabytes  maximum estimated memory use; zero for no limit.
+ */
+void LGParseSCM::do_cache_config(int entries, double megabytes)
+{
+	if (entries < 0) entries = 0;
+	if (megabytes < 0.0) megabytes = 0.0;
+	lg_parse_cache().set_limits(entries, megabytes * 1024.0 * 1024.0);
+}
+
+/**
+ * Implementation of the "lg-parse-cache-stats" scheme primitive.
+ *
+ * @return   FloatValue holding hits, misses, evictions, entries, bytes.
+ */
+ValuePtr LGParseSCM::do_cache_stats(void)
+{
+	LGParseCache::Stats st = lg_parse_cache().get_stats();
+	return createFloatValue(std::vector<double>({
+		(double) st.hits, (double) st.misses, (double) st.evictions,
+		(double) st.entries, (double) st.bytes}));
+}
+
+// Global initialization via constructor
+static __attribute__ ((constructor)) void init(void)
+{
+	static LGParseSCM lgparse;
+}
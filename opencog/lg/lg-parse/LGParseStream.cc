@@ -0,0 +1,411 @@
+/*
+ * LGParseStream.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/core/NumberNode.h>
+#include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atoms/value/QueueValue.h>
+#include <opencog/atoms/value/StringValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/util/Logger.h>
+#include "LGParseLink.h"
+#include "LGParseStream.h"
+
+using namespace opencog;
+void error_handler(lg_errinfo *ei, void *data);
+
+/// The expected format of an LgParseStream is:
+///
+///     LgParseStream
+///         LgParseBonds          -- or any other LgParse* link
+///             <stream of sentences>
+///             LgDictNode "en"
+///             NumberNode 1
+///         NumberNode 16         -- optional, size of in-flight window
+///
+/// The first argument of the wrapped LgParse* link must be executable;
+/// each execution should return the next sentence (or the next few
+/// sentences) as a Node, StringValue or LinkValue. A VoidValue or an
+/// empty StringValue signals end-of-file.
+///
+void LGParseStream::init()
+{
+	const HandleSeq& oset = _outgoing;
+
+	size_t osz = oset.size();
+	if (1 > osz or 2 < osz)
+		throw InvalidParamException(TRACE_INFO,
+			"LgParseStream: Expecting one or two arguments, got %lu", osz);
+
+	Type pst = oset[0]->get_type();
+	if (not nameserver().isA(pst, LG_PARSE_LINK) and
+	    VARIABLE_NODE != pst and GLOB_NODE != pst)
+		throw InvalidParamException(TRACE_INFO,
+			"LgParseStream: Expecting LgParseLink, got %s",
+			oset[0]->to_string().c_str());
+
+	if (2 == osz)
+	{
+		Type nit = oset[1]->get_type();
+		if (NUMBER_NODE != nit and VARIABLE_NODE != nit and GLOB_NODE != nit)
+			throw InvalidParamException(TRACE_INFO,
+				"LgParseStream: Expecting NumberNode, got %s",
+				oset[1]->to_string().c_str());
+	}
+}
+
+LGParseStream::LGParseStream(const HandleSeq&& oset, Type t)
+	: FunctionLink(std::move(oset), t)
+{
+	// Type must be as expected
+	if (not nameserver().isA(t, LG_PARSE_STREAM))
+	{
+		const std::string& tname = nameserver().getTypeName(t);
+		throw InvalidParamException(TRACE_INFO,
+			"Expecting an LgParseStream, got %s", tname.c_str());
+	}
+	init();
+}
+
+/// The in-flight window: the number of sentences being parsed, plus
+/// the number of results that the consumer has not yet drained.
+/// Defaults to twice the number of parser threads.
+size_t LGParseStream::get_window(size_t nthreads) const
+{
+	if (2 == _outgoing.size())
+	{
+		double win = NumberNodeCast(_outgoing[1])->get_value();
+		if (1.0 <= win) return (size_t) win;
+	}
+	return 2 * nthreads;
+}
+
+// =================================================================
+
+namespace {
+
+/// The state shared by the pipeline driver and the parser threads.
+struct Pipeline
+{
+	LGParseLinkPtr parser;
+	LgParseSettings settings;
+	AtomSpacePtr asp;
+	size_t window;
+
+	// The consumer holds the queue; the pipeline does not. Once the
+	// consumer lets go of it, or closes it, the pipeline stops.
+	std::weak_ptr<QueueValue> results;
+
+	std::mutex mtx;
+	std::condition_variable cv;
+
+	// Sentences pulled from upstream, but not yet let into the window.
+	// Only the driver touches these.
+	std::deque<std::string> backlog;
+
+	// Sentences waiting for a parser thread, with sequence numbers.
+	std::deque<std::pair<size_t, std::string>> todo;
+
+	// Parses that finished ahead of an earlier sentence.
+	std::map<size_t, ValuePtr> done;
+
+	size_t next_seq = 0;
+	size_t next_emit = 0;
+	size_t in_flight = 0;
+	bool eof = false;
+
+	// Set when the module is unloaded; see StreamDrivers.
+	bool stop = false;
+
+	// Set when the driver is done, so that its thread can be joined.
+	std::atomic<bool> finished{false};
+
+	bool pull(const Handle&);
+	void work();
+	void drive(const Handle&, size_t);
+};
+
+/// Pull the next chunk of sentences from upstream, and put them on
+/// the backlog. Returns false at end-of-file. Anything that goes
+/// wrong upstream, including a Value that is not a sentence, is
+/// logged, and ends the stream.
+bool Pipeline::pull(const Handle& upstream)
+{
+	try
+	{
+		ValuePtr vp(upstream->execute(asp.get(), true));
+
+		// Unpack whatever we got into a list of sentences.
+		if (vp->is_type(LINK_VALUE))
+		{
+			for (const ValuePtr& v : LinkValueCast(vp)->value())
+			{
+				std::string phrase;
+				if (not LGParseLink::get_phrase(v, phrase))
+					return false;
+				backlog.emplace_back(std::move(phrase));
+			}
+			return true;
+		}
+
+		if (vp->is_type(STRING_VALUE))
+		{
+			const std::vector<std::string>& sli = StringValueCast(vp)->value();
+			backlog.insert(backlog.end(), sli.begin(), sli.end());
+			return (0 < sli.size());
+		}
+
+		std::string phrase;
+		if (not LGParseLink::get_phrase(vp, phrase))
+			return false;
+		backlog.emplace_back(std::move(phrase));
+		return true;
+	}
+	catch (const std::exception& ex)
+	{
+		logger().warn("LgParseStream: upstream failed: %s", ex.what());
+		return false;
+	}
+}
+
+/// Parser thread main loop.
+void Pipeline::work()
+{
+	// The LG error handler is per-thread.
+	lg_error_set_handler(error_handler, nullptr);
+
+	while (true)
+	{
+		std::pair<size_t, std::string> item;
+		{
+			std::unique_lock<std::mutex> lck(mtx);
+			cv.wait(lck, [&] { return eof or not todo.empty(); });
+			if (todo.empty()) return;
+			item = std::move(todo.front());
+			todo.pop_front();
+		}
+
+		ValuePtr result;
+		try
+		{
+			// Fetched anew for each sentence, so that a reloaded
+			// dictionary is picked up right away.
+			result = parser->parse_phrase(item.second.c_str(),
+			                              parser->get_dictionary(),
+			                              settings, asp.get());
+		}
+		catch (const std::exception& ex)
+		{
+			logger().warn("%s", ex.what());
+			result = parser->no_parses(settings, asp.get());
+		}
+
+		// Hand over everything that is now in order. If the consumer
+		// is gone, or has closed the queue, the results are dropped.
+		std::lock_guard<std::mutex> lck(mtx);
+		QueueValuePtr queue(results.lock());
+		done.emplace(item.first, std::move(result));
+		while (not done.empty() and done.begin()->first == next_emit)
+		{
+			if (queue and not queue->is_closed())
+			{
+				try { queue->add(std::move(done.begin()->second)); }
+				catch (...) {}  // Closed in the meanwhile.
+			}
+			done.erase(done.begin());
+			next_emit++;
+			in_flight--;
+		}
+		cv.notify_all();
+	}
+}
+
+/// Pipeline driver. Pulls sentences until end-of-file, but never lets
+/// more than `window` sentences be in flight or sitting undrained in
+/// the results queue; sentences pulled in a chunk wait on the backlog
+/// until there is room for them. Then waits for the parsers, and
+/// closes the queue. Stops early if the consumer lets go of the queue
+/// or closes it, or if the module is being unloaded.
+void Pipeline::drive(const Handle& upstream, size_t nthreads)
+{
+	std::vector<std::thread> pool;
+	for (size_t t=0; t<nthreads; t++)
+		pool.emplace_back(&Pipeline::work, this);
+
+	bool more = true;
+	bool quit = false;
+	while (not quit and (more or not backlog.empty()))
+	{
+		if (backlog.empty())
+		{
+			more = pull(upstream);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lck(mtx);
+
+		// The parser threads wake us when they hand over a result;
+		// but QueueValue has no way of telling us when the consumer
+		// takes one off, so the wait for room also has to time out,
+		// and look again. The queue is not held while waiting.
+		while (true)
+		{
+			QueueValuePtr queue(results.lock());
+			if (stop or nullptr == queue or queue->is_closed())
+			{
+				quit = true;
+				break;
+			}
+			if (in_flight + queue->size() < window) break;
+			queue.reset();
+			cv.wait_for(lck, std::chrono::milliseconds(10));
+		}
+		if (quit) break;
+
+		todo.emplace_back(next_seq++, std::move(backlog.front()));
+		backlog.pop_front();
+		in_flight++;
+		cv.notify_all();
+	}
+
+	{
+		std::lock_guard<std::mutex> lck(mtx);
+		eof = true;
+
+		// No one wants the rest.
+		if (quit) todo.clear();
+	}
+	cv.notify_all();
+	for (std::thread& th : pool)
+		th.join();
+
+	QueueValuePtr queue(results.lock());
+	if (queue and not queue->is_closed()) queue->close();
+	finished = true;
+}
+
+/// The driver threads. Each one is joined once it is done, the next
+/// time that a stream is started; those still running when the module
+/// is unloaded are told to stop, and joined then, so that none of them
+/// outlives the AtomSpace, the parser, or Link Grammar.
+class StreamDrivers
+{
+	std::mutex _mtx;
+	std::list<std::pair<std::shared_ptr<Pipeline>, std::thread>> _drivers;
+
+public:
+	void start(const std::shared_ptr<Pipeline>& pl, const Handle& upstream,
+	           size_t nthreads)
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		for (auto it = _drivers.begin(); it != _drivers.end(); )
+		{
+			if (it->first->finished)
+			{
+				it->second.join();
+				it = _drivers.erase(it);
+			}
+			else it++;
+		}
+
+		_drivers.emplace_back(pl, std::thread([pl, upstream, nthreads]() {
+			pl->drive(upstream, nthreads);
+		}));
+	}
+
+	~StreamDrivers()
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		for (auto& dr : _drivers)
+		{
+			{
+				std::lock_guard<std::mutex> plck(dr.first->mtx);
+				dr.first->stop = true;
+			}
+			dr.first->cv.notify_all();
+		}
+		for (auto& dr : _drivers)
+			dr.second.join();
+	}
+};
+
+static StreamDrivers& stream_drivers(void)
+{
+	static StreamDrivers drivers;
+	return drivers;
+}
+
+} // anonymous namespace
+
+// =================================================================
+
+ValuePtr LGParseStream::execute(AtomSpace* as, bool silent)
+{
+	if (not nameserver().isA(_outgoing[0]->get_type(), LG_PARSE_LINK))
+		throw InvalidParamException(TRACE_INFO,
+			"LgParseStream: Invalid outgoing set at 0; expecting LgParseLink");
+
+	if (2 == _outgoing.size() and
+	    NUMBER_NODE != _outgoing[1]->get_type())
+		throw InvalidParamException(TRACE_INFO,
+			"LgParseStream: Invalid outgoing set at 1; expecting NumberNode");
+
+	LGParseLinkPtr plp(LGParseLinkCast(_outgoing[0]));
+	const Handle& upstream = plp->getOutgoingAtom(0);
+	if (not upstream->is_executable())
+		throw InvalidParamException(TRACE_INFO,
+			"LgParseStream: Expecting an executable sentence source, got %s",
+			upstream->to_string().c_str());
+
+	auto pl = std::make_shared<Pipeline>();
+	pl->parser = plp;
+	plp->get_dictionary();  // Check that it can be had, up front.
+	pl->settings = plp->get_settings();
+
+	// One thread per sentence; the linkages don't get their own.
+	size_t nthreads = pl->settings.num_threads;
+	pl->settings.linkage_threads = 1;
+	pl->asp = AtomSpaceCast(as->get_handle());
+	pl->window = get_window(nthreads);
+
+	// The caller gets the only reference to the queue.
+	QueueValuePtr qvp(createQueueValue());
+	pl->results = qvp;
+
+	// The driver holds on to the pipeline, and thus the parser and
+	// the AtomSpace, until it is done.
+	stream_drivers().start(pl, upstream, nthreads);
+
+	return qvp;
+}
+
+DEFINE_LINK_FACTORY(LGParseStream, LG_PARSE_STREAM)
+
+/* ===================== END OF FILE ===================== */
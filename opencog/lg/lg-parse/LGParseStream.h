@@ -0,0 +1,78 @@
+/*
+ * LGParseStream.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_LG_PARSE_STREAM_H
+#define _OPENCOG_LG_PARSE_STREAM_H
+
+#include <opencog/atoms/core/FunctionLink.h>
+#include <opencog/lg/types/atom_types.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// Streaming Link Grammar parser.
+///
+/// The LgParseStream turns any of the LgParse* links into a pipeline
+/// stage. The expected format is:
+///
+///     LgParseStream
+///         LgParseBonds          -- or any other LgParse* link
+///             <stream of sentences>
+///             LgDictNode "en"
+///             NumberNode 1
+///         NumberNode 16         -- optional, size of in-flight window
+///
+/// When executed, it immediately returns a QueueValue. Sentences are
+/// pulled from the upstream stream in the background, and parsed on
+/// a pool of worker threads. Results are pushed onto the QueueValue,
+/// in input order, as they finish. The number of sentences that are
+/// being parsed, plus the number of results not yet drained from the
+/// queue, is bounded by the window; once it is full, no more sentences
+/// are pulled until the consumer catches up. When the upstream reports
+/// end-of-file, the QueueValue is closed. If the consumer closes the
+/// QueueValue, or lets go of it, the stream stops.
+
+class LGParseStream : public FunctionLink
+{
+protected:
+	void init();
+	size_t get_window(size_t) const;
+
+public:
+	LGParseStream(const HandleSeq&&, Type=LG_PARSE_STREAM);
+	LGParseStream(const LGParseStream&) = delete;
+	LGParseStream& operator=(const LGParseStream&) = delete;
+
+	// Return the stream of parse results.
+	virtual ValuePtr execute(AtomSpace*, bool);
+
+	static Handle factory(const Handle&);
+};
+
+LINK_PTR_DECL(LGParseStream)
+#define createLGParseStream CREATE_DECL(LGParseStream)
+
+/** @}*/
+}
+#endif // _OPENCOG_LG_PARSE_STREAM_H
@@ -4,8 +4,12 @@
  * Unified initialization for Link Grammar Atomese module
  */
 
+#include <opencog/lg/lg-dict/LGDictRegistry.h>
+
 extern "C" {
 void opencog_lg_init(void) {
-	// Nothing to do - loading this library triggers all constructors
+	// Loading this library triggers all constructors. After that,
+	// start opening any dictionaries that were asked for ahead of time.
+	opencog::lg_dict_registry().start_preload();
 }
 };
@@ -32,3 +32,160 @@
      This checks the connector strings for linkability, using the
      standard Link Grammar connector matching rules.
 ")
+
+(export lg-dict-evict)
+(set-procedure-property! lg-dict-evict 'documentation
+"
+  lg-dict-evict LANG
+     Close the open dictionaries for the language LANG (a string, such
+     as \"en\"), in all AtomSpace/StorageNode configurations. All
+     LgDictNodes let go of them; parses that are running finish first.
+     The next LgDictNode to ask for one gets a freshly opened copy.
+     Returns the number of dictionaries evicted.
+
+     Dictionaries are shared by all LgDictNodes of the same name, in
+     all AtomSpaces, and are normally closed when the last LgDictNode
+     using them is deleted.
+")
+
+(export lg-dict-open-count)
+(set-procedure-property! lg-dict-open-count 'documentation
+"
+  lg-dict-open-count
+     Return the number of open Link Grammar dictionaries. This counts
+     the dictionaries that are still held by running parses, as well.
+")
+
+(export lg-dict-preload)
+(set-procedure-property! lg-dict-preload 'documentation
+"
+  lg-dict-preload LANG
+     Start opening the dictionary for the language LANG (a string, such
+     as \"en\"), on a background thread, and return right away. Once
+     open, a few sentences are parsed with it, to warm it up. It then
+     stays open, even when no LgDictNode is using it, until evicted
+     with `lg-dict-evict`. Use `lg-dict-ready?` to find out when it is
+     done.
+
+     Dictionaries can also be preloaded when this module is loaded, by
+     listing them in the LG_ATOMESE_PRELOAD environment variable, e.g.
+     LG_ATOMESE_PRELOAD=\"en ru\".
+")
+
+(export lg-dict-ready?)
+(set-procedure-property! lg-dict-ready? 'documentation
+"
+  lg-dict-ready? LANG
+     Return #t if the dictionary for the language LANG has been
+     preloaded and warmed up. If LANG is the empty string, return #t
+     if no preloads are still in progress. Meant for health checks.
+")
+
+(export lg-dict-reload)
+(set-procedure-property! lg-dict-reload 'documentation
+"
+  lg-dict-reload DICT
+     Reopen the dictionaries of the LgDictNode DICT, on a background
+     thread, and return right away. The fresh dictionaries are used by
+     all LgDictNodes of the same name, in all AtomSpaces. Parses
+     started after the reload finishes use them; parses already under
+     way carry on with the old ones, which are closed once the last of
+     them is done. Use this to pick up a dictionary that has changed
+     on disk, without stopping the parsers. Returns #f if a reload is
+     already under way.
+
+     Example:
+        (lg-dict-reload (LgDictNode \"en\"))
+")
+
+(export lg-dict-reload-stats)
+(set-procedure-property! lg-dict-reload-stats 'documentation
+"
+  lg-dict-reload-stats DICT
+     Return a FloatValue holding, for the LgDictNode DICT: the number
+     of reloads done, the time (in seconds) that the last one took,
+     and 1 if a reload is under way right now, else 0.
+")
+
+(export lg-dict-cache-config)
+(set-procedure-property! lg-dict-cache-config 'documentation
+"
+  lg-dict-cache-config DICT MAX-ENTRIES MAX-MEGABYTES
+     Set the limits of the dictionary-entry cache of the LgDictNode
+     DICT. The cache holds the disjuncts of at most MAX-ENTRIES words,
+     using at most (about) MAX-MEGABYTES of memory; Atoms shared by
+     several words are counted once. Set MAX-MEGABYTES to zero for no
+     memory limit. Set MAX-ENTRIES to zero to turn the cache off and
+     empty it. The default is 4096 words, 128 megabytes.
+
+     LgDictEntry looks up each word only once; repeated lookups of
+     the same word return the same disjuncts. The cache is emptied
+     when the dictionary is reloaded.
+")
+
+(export lg-dict-cache-stats)
+(set-procedure-property! lg-dict-cache-stats 'documentation
+"
+  lg-dict-cache-stats DICT
+     Return a FloatValue holding the dictionary-entry cache counters of
+     the LgDictNode DICT: hits, misses, evictions, number of entries,
+     and estimated bytes.
+")
+
+(export lg-dict-filter-config)
+(set-procedure-property! lg-dict-filter-config 'documentation
+"
+  lg-dict-filter-config DICT ON
+     Turn the word filter of the LgDictNode DICT on (ON is #t) or off.
+     Returns #t if the filter is on. It is off by default.
+
+     The filter is built from the word list of the dictionary, and
+     lets LgHaveDictEntry answer most checks for words that are not in
+     it, without a dictionary lookup; words that are found are cached.
+     It is rebuilt when the dictionary is reloaded. It gives the same
+     answers as the dictionary, and so only rejects words made of
+     lowercase letters. It can be turned on only for dictionaries that
+     are read from files, and whose regex file shows that none of its
+     regexes can match such a word. For all others, it stays off, and
+     #f is returned. This includes \"en\", whose regexes guess at
+     words by their endings, and dictionaries backed by an AtomSpace
+     or a database, whose word lists hold only the words loaded so far.
+")
+
+(export lg-dict-filter-stats)
+(set-procedure-property! lg-dict-filter-stats 'documentation
+"
+  lg-dict-filter-stats DICT
+     Return a FloatValue holding the word-filter counters of the
+     LgDictNode DICT: queries, rejects (answered by the filter), hits
+     (answered by the cache of known words), lookups (passed on to the
+     dictionary), false positives (passed on, but not found), number
+     of words in the filter, and its size in bytes.
+")
+
+; Export functions from lg-parse
+(export lg-parse-cache-config)
+(set-procedure-property! lg-parse-cache-config 'documentation
+"
+  lg-parse-cache-config MAX-ENTRIES MAX-MEGABYTES
+     Turn on the parse-result cache, holding at most MAX-ENTRIES parse
+     results, using at most (about) MAX-MEGABYTES of memory. Set
+     MAX-MEGABYTES to zero for no memory limit. Set MAX-ENTRIES to
+     zero to turn the cache off and empty it. The cache is off by
+     default.
+
+     When the cache is on, repeated parses of the same sentence, with
+     the same dictionary, linkage count, parse options and LgParse*
+     type, return the earlier result. It is never used for the \"any\"
+     language (whose parses are random on purpose), for AtomSpace-backed
+     dictionaries, or for sentences having more linkages than the
+     linkage limit (these are randomly sampled).
+")
+
+(export lg-parse-cache-stats)
+(set-procedure-property! lg-parse-cache-stats 'documentation
+"
+  lg-parse-cache-stats
+     Return a FloatValue holding the parse-result cache counters:
+     hits, misses, evictions, number of entries, and estimated bytes.
+")
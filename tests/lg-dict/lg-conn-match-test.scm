@@ -0,0 +1,57 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; lg-conn-match-test.scm
+;
+; Unit test for lg-conn-type-match? and lg-conn-linkable?
+
+(use-modules (srfi srfi-64))
+(use-modules (opencog))
+(use-modules (opencog lg))
+
+(use-modules (opencog test-runner))
+
+(opencog-test-runner)
+
+(define tname "lg-conn-match-test")
+(test-begin tname)
+
+(define (conn name dir) (LgConnector (LgConnNode name) (LgConnDirNode dir)))
+(define (match? a b) (lg-conn-type-match? (conn a "+") (conn b "-")))
+
+; Plain names, subscripts and wildcards.
+(test-assert "Same name" (match? "Ss" "Ss"))
+(test-assert "No subscript" (match? "S" "Ss"))
+(test-assert "Shorter name" (match? "S" "SX"))
+(test-assert "Wildcard subscript" (match? "S*s" "Sps"))
+(test-assert "Wildcard both ways" (match? "Sp" "S*"))
+(test-assert "Subscript mismatch" (not (match? "Ss" "Sp")))
+(test-assert "Uppercase mismatch" (not (match? "SX" "SY")))
+(test-assert "Wildcard is not uppercase" (not (match? "S*" "SX")))
+
+; Head and tail markers.
+(test-assert "Head to tail" (match? "hSs" "dSs"))
+(test-assert "Head to plain" (match? "hSs" "Ss"))
+(test-assert "Head to head" (not (match? "hSs" "hSs")))
+(test-assert "Tail to tail" (not (match? "dSs" "dS")))
+
+; Names too long to be packed are matched by name.
+(test-assert "Long names"
+	(match? "ABCDEFGHIJKLMNOPQRSTUVWXYZ" "ABCDEFGHIJKLMNOPQRSTUVWXYZ"))
+(test-assert "Long vs. short" (match? "ABCDEFGHIJKLMNOPQRSTUVWXYZ" "ABC"))
+(test-assert "Long mismatch"
+	(not (match? "ABCDEFGHIJKLMNOPQRSTUVWXYa" "ABCDEFGHIJKLMNOPQRSTUVWXYb")))
+(test-assert "Mismatch past the first word"
+	(not (match? "ABCDEFGHIJKs" "ABCDEFGHIJKp")))
+
+; Linking also needs opposite directions.
+(test-assert "Linkable" (lg-conn-linkable? (conn "Ss" "+") (conn "S" "-")))
+(test-assert "Same direction"
+	(not (lg-conn-linkable? (conn "Ss" "+") (conn "S" "+"))))
+(test-assert "Not linkable"
+	(not (lg-conn-linkable? (conn "Ss" "+") (conn "Sp" "-"))))
+
+(test-end tname)
+
+(opencog-test-end)
@@ -6,6 +6,7 @@
 ;
 ; Unit test for LgDictEntry and LgHaveDictEntry
 
+(use-modules (srfi srfi-1))
 (use-modules (srfi srfi-64))
 (use-modules (opencog))
 (use-modules (opencog exec))
@@ -42,6 +43,110 @@
 (test-assert "LgHaveDictEntry rejects non-existent word"
 	(equal? (BoolValue #f) no-have-test))
 
+; Repeated lookups come out of the cache, and give the same answer.
+(define (cache-stat i)
+	(list-ref (cog-value->list (lg-dict-cache-stats (LgDictNode "en"))) i))
+(define hits-before (cache-stat 0))
+(define again
+	(cog-execute!
+		(LgDictEntry (Word "test") (LgDictNode "en"))))
+
+(test-assert "Cached lookup is the same"
+	(equal? (cog-value->list dict-result) (cog-value->list again)))
+(test-equal "One more hit" (+ 1 hits-before) (cache-stat 0))
+(test-assert "Memory is counted" (< 0 (cache-stat 4)))
+
+; Turning the cache off empties it.
+(lg-dict-cache-config (LgDictNode "en") 0 0)
+(test-equal "Cache is empty" 0.0 (cache-stat 3))
+(test-equal "No memory counted" 0.0 (cache-stat 4))
+(test-assert "Uncached lookup is the same"
+	(equal? (cog-value->list dict-result)
+		(cog-value->list
+			(cog-execute! (LgDictEntry (Word "test") (LgDictNode "en"))))))
+
+; Connectors that two words have in common are counted once.
+(define (cached-bytes words)
+	(lg-dict-cache-config (LgDictNode "en") 0 0)
+	(lg-dict-cache-config (LgDictNode "en") 4096 128)
+	(for-each
+		(lambda (w) (cog-execute! (LgDictEntry (Word w) (LgDictNode "en"))))
+		words)
+	(cache-stat 4))
+(define dog-bytes (cached-bytes (list "dog")))
+(define cat-bytes (cached-bytes (list "cat")))
+(test-assert "Shared Atoms are counted once"
+	(< (cached-bytes (list "dog" "cat")) (+ dog-bytes cat-bytes)))
+
+; A list of words is looked up as a batch, one result per word.
+(lg-dict-cache-config (LgDictNode "en") 4096 128)
+(define batch
+	(cog-value->list (cog-execute!
+		(LgDictEntry
+			(List (Word "test") (Word "asdfqwerzxcv") (Word "test"))
+			(LgDictNode "en")))))
+
+(test-equal "One result per word" 3 (length batch))
+(test-assert "Batch lookup is the same"
+	(lset= equal? (cog-value->list dict-result)
+		(cog-value->list (list-ref batch 0))))
+(test-assert "Unknown word in a batch"
+	(null? (cog-value->list (list-ref batch 1))))
+(test-assert "Repeated word in a batch"
+	(equal? (cog-value->list (list-ref batch 0))
+		(cog-value->list (list-ref batch 2))))
+
+(test-equal "LgHaveDictEntry batch"
+	(BoolValue #t #f #t)
+	(cog-execute!
+		(LgHaveDictEntry
+			(List (Word "test") (Word "asdfqwerzxcv") (Word "the"))
+			(LgDictNode "en"))))
+
+; The word filter is refused for "en": its regexes guess at lowercase
+; words by their endings, so a word not in its word list may still be
+; known.
+(test-assert "No word filter for en"
+	(not (lg-dict-filter-config (LgDictNode "en") #t)))
+(test-equal "Regex word, without filter"
+	(BoolValue #t)
+	(cog-execute! (LgHaveDictEntry (Word "42") (LgDictNode "en"))))
+
+; A dictionary the filter is meant for: read from files, with regexes
+; that match only numbers and capitalized words.
+(define filter-dict
+	(LgDictNode (canonicalize-path
+		(string-append (dirname (current-filename)) "/filter-dict"))))
+(define (have-word w)
+	(cog-execute! (LgHaveDictEntry (Word w) filter-dict)))
+(define some-words (list "cat" "the" "zebra" "asdfqwerzxcv" "42" "Fred" "x-ray"))
+(define some-unfiltered (map have-word some-words))
+
+(test-assert "Word filter is on"
+	(lg-dict-filter-config filter-dict #t))
+(test-equal "Known word, with filter" (BoolValue #t) (have-word "cat"))
+(test-equal "Unknown word, with filter" (BoolValue #f) (have-word "zebra"))
+
+(define (filter-stat i)
+	(list-ref (cog-value->list (lg-dict-filter-stats filter-dict)) i))
+(test-equal "Two queries" 2.0 (filter-stat 0))
+(test-assert "Words are in the filter" (<= 40 (filter-stat 5)))
+
+; Each of these could get past the Bloom filter, but hardly all.
+(for-each have-word (list "qqq" "blorf" "wug" "zorp" "asdfqwerzxcv"))
+(test-assert "Lowercase misses are rejected" (< 0 (filter-stat 1)))
+
+(test-equal "Same answers, with filter" some-unfiltered (map have-word some-words))
+(test-assert "A number is known" (equal? (BoolValue #t) (have-word "42")))
+(define rejects-before (filter-stat 1))
+(have-word "31337")
+(have-word "Zqxjvwton")
+(test-equal "Numbers and capitals are not rejected"
+	rejects-before (filter-stat 1))
+
+(test-assert "Word filter is off"
+	(not (lg-dict-filter-config filter-dict #f)))
+
 (test-end tname)
 
 (opencog-test-end)
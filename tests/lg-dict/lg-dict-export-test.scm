@@ -0,0 +1,67 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; lg-dict-export-test.scm
+;
+; Unit test for LgDictExport. Uses the tiny "any" dictionary, so that
+; the whole of it can be exported quickly.
+
+(use-modules (srfi srfi-64))
+(use-modules (opencog))
+(use-modules (opencog exec))
+(use-modules (opencog lg))
+(use-modules (opencog persist) (opencog persist-file))
+
+(use-modules (opencog test-runner))
+
+(opencog-test-runner)
+
+(define tname "lg-dict-export-test")
+(test-begin tname)
+
+(define export (LgDictExport (LgDictNode "any") (Number 2)))
+(define counts (cog-value->list (cog-execute! export)))
+
+(test-assert "Some words" (< 0 (list-ref counts 1)))
+(test-equal "All words done" (list-ref counts 1) (list-ref counts 0))
+(test-assert "Some disjuncts" (< 0 (list-ref counts 2)))
+
+(test-equal "Progress is kept on the link"
+	counts
+	(cog-value->list (cog-value export (Predicate "*-lg-export-progress-*"))))
+
+; Words with several subscripts can have the same disjunct more than
+; once; it is the same Atom.
+(define nsections (length (cog-get-atoms 'LgDisjunct)))
+(test-assert "Disjuncts are in the AtomSpace"
+	(and (< 0 nsections) (<= nsections (list-ref counts 2))))
+
+; Export to a file. Nothing goes into the AtomSpace; loading the file
+; back gives the same disjuncts.
+(define base-as (cog-atomspace))
+(define file-name "/tmp/lg-dict-export-test.scm")
+(if (file-exists? file-name) (delete-file file-name))
+
+(cog-set-atomspace! (cog-new-atomspace))
+(define fsn (FileStorageNode file-name))
+(cog-open fsn)
+(define file-counts
+	(cog-value->list (cog-execute! (LgDictExport (LgDictNode "any") fsn))))
+(cog-close fsn)
+(test-equal "All words written" (list-ref counts 1) (list-ref file-counts 0))
+(test-equal "All disjuncts written" (list-ref counts 2) (list-ref file-counts 2))
+(test-equal "Nothing in the AtomSpace" 0 (length (cog-get-atoms 'LgDisjunct)))
+
+(cog-set-atomspace! (cog-new-atomspace))
+(define fsn-in (FileStorageNode file-name))
+(cog-open fsn-in)
+(load-atomspace fsn-in)
+(cog-close fsn-in)
+(test-equal "Same disjuncts read back" nsections
+	(length (cog-get-atoms 'LgDisjunct)))
+(cog-set-atomspace! base-as)
+
+(test-end tname)
+
+(opencog-test-end)
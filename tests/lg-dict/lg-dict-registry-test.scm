@@ -0,0 +1,106 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; lg-dict-registry-test.scm
+;
+; Unit test for sharing dictionaries between AtomSpaces.
+
+(use-modules (srfi srfi-64))
+(use-modules (opencog))
+(use-modules (opencog exec))
+(use-modules (opencog lg))
+
+(use-modules (opencog test-runner))
+
+(opencog-test-runner)
+
+(define tname "lg-dict-registry-test")
+(test-begin tname)
+
+(define (have-dog)
+	(cog-execute! (LgHaveDictEntry (Word "dog") (LgDictNode "en"))))
+
+(test-equal "Nothing open yet" 0 (lg-dict-open-count))
+
+(test-assert "Found in the first AtomSpace" (equal? (BoolValue #t) (have-dog)))
+(test-equal "One open" 1 (lg-dict-open-count))
+
+; A different AtomSpace, with its own LgDictNode, shares the dict.
+(define base-as (cog-atomspace))
+(define other-as (cog-new-atomspace))
+(cog-set-atomspace! other-as)
+(test-assert "Found in the second AtomSpace" (equal? (BoolValue #t) (have-dog)))
+(test-equal "Still one open" 1 (lg-dict-open-count))
+(cog-set-atomspace! base-as)
+
+; Evicting closes it, even though both LgDictNodes are still around.
+(test-equal "Evict it" 1 (lg-dict-evict "en"))
+(test-equal "None left" 0 (lg-dict-open-count))
+
+; The next lookup opens a fresh copy, again shared by both.
+(test-assert "Found after evict" (equal? (BoolValue #t) (have-dog)))
+(test-equal "Reopened" 1 (lg-dict-open-count))
+(cog-set-atomspace! other-as)
+(test-assert "Found again in the second AtomSpace"
+	(equal? (BoolValue #t) (have-dog)))
+(test-equal "Reopened just once" 1 (lg-dict-open-count))
+(cog-set-atomspace! base-as)
+
+(test-equal "Evict it again" 1 (lg-dict-evict "en"))
+(test-equal "None left again" 0 (lg-dict-open-count))
+
+; Preload in the background, and wait for it.
+(lg-dict-preload "en")
+(define (wait-ready n)
+	(if (and (< 0 n) (not (lg-dict-ready? "en")))
+		(begin (usleep 100000) (wait-ready (- n 1)))))
+(wait-ready 600)
+(test-assert "Preloaded" (lg-dict-ready? "en"))
+(test-assert "Nothing pending" (lg-dict-ready? ""))
+(test-equal "Pinned open" 1 (lg-dict-open-count))
+
+; LgDictNodes get the preloaded copy, in both AtomSpaces. Had either
+; opened its own, there would be more than one open.
+(test-assert "Found after preload" (equal? (BoolValue #t) (have-dog)))
+(test-equal "Still just the one" 1 (lg-dict-open-count))
+(cog-set-atomspace! other-as)
+(test-assert "Found after preload, in the second AtomSpace"
+	(equal? (BoolValue #t) (have-dog)))
+(test-equal "Still just the one, shared" 1 (lg-dict-open-count))
+(cog-set-atomspace! base-as)
+
+; The preloaded copy is the one that the LgDictNodes hold; evicting
+; it leaves nothing open.
+(test-equal "Evict the preload" 1 (lg-dict-evict "en"))
+(test-assert "No longer ready" (not (lg-dict-ready? "en")))
+(test-equal "Nothing open after the preload is evicted" 0
+	(lg-dict-open-count))
+
+; Reload, and wait for it.
+(define dict (LgDictNode "en"))
+(test-assert "Found before reload" (equal? (BoolValue #t) (have-dog)))
+(test-assert "Reload started" (lg-dict-reload dict))
+(define (wait-reload n)
+	(if (and (< 0 n)
+			(< 0.5 (list-ref (cog-value->list (lg-dict-reload-stats dict)) 2)))
+		(begin (usleep 100000) (wait-reload (- n 1)))))
+(wait-reload 600)
+(test-equal "One reload done" 1.0
+	(car (cog-value->list (lg-dict-reload-stats dict))))
+(test-assert "Found after reload" (equal? (BoolValue #t) (have-dog)))
+
+; The old copy was let go, also by the LgDictNode in the second
+; AtomSpace, which now uses the new one.
+(test-equal "Only the new one open" 1 (lg-dict-open-count))
+(cog-set-atomspace! other-as)
+(test-assert "Found after reload, in the second AtomSpace"
+	(equal? (BoolValue #t) (have-dog)))
+(test-equal "Still only the new one open" 1 (lg-dict-open-count))
+(cog-set-atomspace! base-as)
+(test-equal "One copy to evict" 1 (lg-dict-evict "en"))
+(test-equal "Nothing open at the end" 0 (lg-dict-open-count))
+
+(test-end tname)
+
+(opencog-test-end)
@@ -0,0 +1,71 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; lg-dict-stream-test.scm
+;
+; Unit test for LgDictStream
+
+(use-modules (srfi srfi-1))
+(use-modules (srfi srfi-64))
+(use-modules (opencog))
+(use-modules (opencog exec))
+(use-modules (opencog lg))
+
+(use-modules (opencog test-runner))
+
+(opencog-test-runner)
+
+(define tname "lg-dict-stream-test")
+(test-begin tname)
+
+(define entry
+	(cog-value->list (cog-execute!
+		(LgDictEntry (Word "test") (LgDictNode "en")))))
+
+; Drain a stream, returning everything it handed out.
+(define (drain stream)
+	(let loop ((got '()))
+		(define chunk (cog-value->list stream))
+		(if (null? chunk) got (loop (append got chunk)))))
+
+; Without limits, the stream gives the same disjuncts as LgDictEntry,
+; although not in the same order.
+(define stream
+	(cog-execute!
+		(LgDictStream (Word "test") (LgDictNode "en") (Number 0) (Number -1)
+			(Number 7))))
+
+(test-equal "Stream is an LgDisjunctStream"
+	'LgDisjunctStream (cog-type stream))
+
+(define streamed (drain stream))
+(test-equal "No repeats" (length (delete-duplicates streamed)) (length streamed))
+(test-assert "Same disjuncts as LgDictEntry"
+	(lset= equal? entry streamed))
+(test-assert "Stays empty" (null? (cog-value->list stream)))
+
+; The cap stops the stream early.
+(define capped
+	(cog-execute!
+		(LgDictStream (Word "test") (LgDictNode "en") (Number 2))))
+(test-equal "Cap of two" 2 (length (drain capped)))
+
+; The cost limit only ever removes disjuncts.
+(define cheap
+	(drain (cog-execute!
+		(LgDictStream (Word "test") (LgDictNode "en") (Number 0) (Number 0)
+			(Number 100)))))
+(test-assert "Some cheap disjuncts" (< 0 (length cheap)))
+(test-assert "Cheap ones are a subset"
+	(lset<= equal? cheap entry))
+
+; Unknown words give an empty stream.
+(define unknown
+	(cog-execute!
+		(LgDictStream (Word "asdfqwerzxcv") (LgDictNode "en"))))
+(test-assert "Unknown word" (null? (cog-value->list unknown)))
+
+(test-end tname)
+
+(opencog-test-end)
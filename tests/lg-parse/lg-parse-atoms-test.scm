@@ -0,0 +1,81 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; lg-parse-atoms-test.scm
+;
+; Unit test: each LgParse* link adds to the AtomSpace exactly the
+; Atoms that it returns, and nothing else. In particular, WordNodes
+; for null-linked words are made only by the links that list all of
+; the words.
+
+(use-modules (srfi srfi-1))
+(use-modules (srfi srfi-64))
+(use-modules (opencog))
+(use-modules (opencog exec))
+(use-modules (opencog lg))
+
+(use-modules (opencog test-runner))
+
+(opencog-test-runner)
+
+(define tname "lg-parse-atoms-test")
+(test-begin tname)
+
+; All of the Atoms in a Value, and all of the Atoms under them.
+(define (atoms-in val)
+	(cond
+		((cog-atom? val)
+			(cons val (append-map atoms-in (cog-outgoing-set val))))
+		((cog-subtype? 'LinkValue (cog-type val))
+			(append-map atoms-in (cog-value->list val)))
+		(else '())))
+
+(define base-space (cog-atomspace))
+
+; Parse in an empty AtomSpace, and compare what ended up there with
+; what came back.
+(define (check-parse parse-link)
+	(define space (cog-new-atomspace))
+	(cog-set-atomspace! space)
+	(let* ((result (cog-execute! parse-link))
+			(returned (delete-duplicates (atoms-in result)))
+			(present (cog-get-atoms 'Atom #t)))
+		(cog-set-atomspace! base-space)
+		(and
+			(= (length returned) (length present))
+			(every (lambda (a) (member a returned)) present))))
+
+; Some of the words of this one are null-linked.
+(define null-sent (Phrase "the the dog dog ran ran."))
+(define good-sent (Phrase "this is a test."))
+
+(for-each
+	(lambda (ptype)
+		(for-each
+			(lambda (sent)
+				(test-assert
+					(format #f "~a ~a" ptype (cog-name sent))
+					(check-parse
+						(cog-new-link ptype sent (LgDictNode "en") (Number 4)))))
+			(list good-sent null-sent)))
+	'(LgParseLink LgParseBonds LgParseDisjuncts LgParseSections))
+
+; Null-linked words have no WordNodes, when only disjuncts are asked for.
+(define dj-space (cog-new-atomspace))
+(cog-set-atomspace! dj-space)
+(define djs
+	(cog-execute! (LgParseDisjuncts null-sent (LgDictNode "en") (Number 1))))
+(define dj-words (cog-get-atoms 'WordNode))
+(cog-set-atomspace! base-space)
+
+(test-assert "Only the linked words"
+	(every
+		(lambda (w)
+			(any (lambda (dj) (equal? w (cog-outgoing-atom dj 0)))
+				(cog-value->list (cog-value-ref djs 0))))
+		dj-words))
+
+(test-end tname)
+
+(opencog-test-end)
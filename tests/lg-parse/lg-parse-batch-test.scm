@@ -0,0 +1,51 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; lg-parse-batch-test.scm
+;
+; Unit test for batch parsing: several sentences at once.
+
+(use-modules (srfi srfi-64))
+(use-modules (opencog))
+(use-modules (opencog exec))
+(use-modules (opencog lg))
+
+(use-modules (opencog test-runner))
+
+(opencog-test-runner)
+
+(define tname "lg-parse-batch-test")
+(test-begin tname)
+
+; Three sentences, handed over as a single StringValue.
+(cog-set-value! (Anchor "corpus") (Predicate "sentences")
+	(StringValue "this is a test." "I saw the dog." "she runs."))
+
+(cog-set-value! (LgDictNode "en")
+	(Predicate "*-lg-parse-threads-*") (FloatValue 2))
+
+(define batch
+	(cog-execute!
+		(LgParseBonds
+			(ValueOf (Anchor "corpus") (Predicate "sentences"))
+			(LgDictNode "en")
+			(NumberNode 1))))
+
+(test-equal "One result per sentence" 3 (length (cog-value->list batch)))
+
+; Each result holds one linkage; each linkage is (words, bonds).
+(define (first-words N)
+	(cog-value-ref (cog-value-ref (cog-value-ref batch N) 0) 0))
+
+; The results must come back in input order.
+(test-assert "First sentence first"
+	(member (Word "test") (cog-value->list (first-words 0))))
+(test-assert "Second sentence second"
+	(member (Word "dog") (cog-value->list (first-words 1))))
+(test-assert "Third sentence third"
+	(member (Word "runs") (cog-value->list (first-words 2))))
+
+(test-end tname)
+
+(opencog-test-end)
@@ -0,0 +1,127 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; lg-parse-cache-test.scm
+;
+; Unit test for the parse cache: hits and misses, eviction, the
+; "any" language, AtomSpaces, and dictionary reloads.
+
+(use-modules (srfi srfi-64))
+(use-modules (opencog))
+(use-modules (opencog exec))
+(use-modules (opencog lg))
+
+(use-modules (opencog test-runner))
+
+(opencog-test-runner)
+
+(define tname "lg-parse-cache-test")
+(test-begin tname)
+
+(define (parse sent dict)
+	(cog-execute!
+		(LgParseBonds (Phrase sent) (LgDictNode dict) (Number 1))))
+
+; The stats are hits, misses, evictions, entries and bytes.
+(define (stat N) (inexact->exact (list-ref (cog-value->list (lg-parse-cache-stats)) N)))
+(define (hits) (stat 0))
+(define (misses) (stat 1))
+(define (evictions) (stat 2))
+(define (entries) (stat 3))
+
+; Off by default.
+(define h0 (hits))
+(define m0 (misses))
+(parse "this is a test." "en")
+(parse "this is a test." "en")
+(test-equal "Off: no hits" h0 (hits))
+(test-equal "Off: no misses" m0 (misses))
+(test-equal "Off: no entries" 0 (entries))
+
+; On: the first parse misses, the second one hits, and returns the
+; same result.
+(lg-parse-cache-config 2 10)
+(define first-parse (parse "this is a test." "en"))
+(test-equal "First parse misses" (+ m0 1) (misses))
+(define second-parse (parse "this is a test." "en"))
+(test-equal "Second parse hits" (+ h0 1) (hits))
+(test-equal "One entry" 1 (entries))
+(test-assert "Same result" (equal? first-parse second-parse))
+(test-assert "Some bytes" (< 0 (stat 4)))
+
+; A different number of linkages is a different parse.
+(cog-execute!
+	(LgParseBonds (Phrase "this is a test.") (LgDictNode "en") (Number 2)))
+(test-equal "Linkage count is in the key" (+ m0 2) (misses))
+
+; Two entries at most; the oldest goes.
+(define e0 (evictions))
+(parse "I saw the dog." "en")
+(test-equal "Evicted one" (+ e0 1) (evictions))
+(test-equal "Two entries" 2 (entries))
+
+; The "any" language is never cached.
+(define m1 (misses))
+(parse "this is a test." "any")
+(parse "this is a test." "any")
+(test-equal "Any is not looked up" m1 (misses))
+
+; A cached parse is not handed out in another AtomSpace.
+(define base-space (cog-atomspace))
+(define other-space (cog-new-atomspace))
+(cog-set-atomspace! other-space)
+(define h1 (hits))
+(define other-parse (parse "I saw the dog." "en"))
+(test-equal "No hits in another AtomSpace" h1 (hits))
+(test-assert "Result is in the other AtomSpace"
+	(equal? other-space
+		(cog-atomspace (cog-value-ref (cog-value-ref (cog-value-ref other-parse 0) 0) 0))))
+(cog-set-atomspace! base-space)
+
+; A reloaded dictionary does not get the parses made with the old one.
+(define en-dict (LgDictNode "en"))
+(define h3 (hits))
+(parse "I saw the dog." "en")
+(test-equal "Cached before reload" (+ h3 1) (hits))
+(lg-dict-reload en-dict)
+(define (wait-reload n)
+	(if (and (< 0 n)
+			(< 0.5 (list-ref (cog-value->list (lg-dict-reload-stats en-dict)) 2)))
+		(begin (usleep 100000) (wait-reload (- n 1)))))
+(wait-reload 600)
+(define m3 (misses))
+(parse "I saw the dog." "en")
+(test-equal "Missed after reload" (+ m3 1) (misses))
+(test-equal "No hit after reload" (+ h3 1) (hits))
+
+; A parse that runs out of time hands back whatever it found by then;
+; that is not cached. With nulls allowed, this sentence takes much
+; longer than a second to parse in full.
+(define slow-sent
+	(string-append
+		"dog the ran cat the sat of in on the the dog ran ran cat cat "
+		"sat on the of in dog the ran cat the sat of in on the the dog "
+		"ran ran cat cat sat on the of in dog the ran cat the sat of in "
+		"on the the dog ran ran cat cat sat on the of in."))
+(define slow-parse
+	(LgParseBonds (Phrase slow-sent) (LgDictNode "en") (Number 1)))
+(cog-set-value! slow-parse (Predicate "*-lg-max-parse-time-*") (FloatValue 1))
+(cog-set-value! slow-parse (Predicate "*-lg-null-count-*") (FloatValue 0 100))
+(define (try-slow)
+	(catch #t (lambda () (cog-execute! slow-parse)) (lambda (key . args) #f)))
+(define h4 (hits))
+(try-slow)
+(try-slow)
+(test-equal "Timed-out parse is not cached" h4 (hits))
+
+; Zero entries turns it off, and empties it.
+(lg-parse-cache-config 0 0)
+(test-equal "Emptied" 0 (entries))
+(define h2 (hits))
+(parse "I saw the dog." "en")
+(test-equal "Off again" h2 (hits))
+
+(test-end tname)
+
+(opencog-test-end)
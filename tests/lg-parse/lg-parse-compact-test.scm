@@ -0,0 +1,113 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; lg-parse-compact-test.scm
+;
+; Unit test for LgParseCompact: the layout, checked against the
+; disjuncts that LgParseDisjuncts gives for the same sentence.
+
+(use-modules (srfi srfi-1))
+(use-modules (srfi srfi-64))
+(use-modules (opencog))
+(use-modules (opencog exec))
+(use-modules (opencog lg))
+
+(use-modules (opencog test-runner))
+
+(opencog-test-runner)
+
+(define tname "lg-parse-compact-test")
+(test-begin tname)
+
+(define sent (Phrase "I saw the man with the telescope."))
+(define nlkgs 4)
+
+(define compact
+	(cog-value->list
+		(cog-execute! (LgParseCompact sent (LgDictNode "en") (Number nlkgs)))))
+(define disjuncts
+	(cog-value->list
+		(cog-execute! (LgParseDisjuncts sent (LgDictNode "en") (Number nlkgs)))))
+
+; Three string tables, then the linkages.
+(test-assert "Word table" (cog-subtype? 'StringValue (cog-type (first compact))))
+(test-assert "Label table" (cog-subtype? 'StringValue (cog-type (second compact))))
+(test-assert "Disjunct table" (cog-subtype? 'StringValue (cog-type (third compact))))
+
+(define words (list->vector (cog-value->list (first compact))))
+(define labels (list->vector (cog-value->list (second compact))))
+(define djs (list->vector (cog-value->list (third compact))))
+(define linkages (drop compact 3))
+
+(test-equal "Same number of linkages" (length disjuncts) (length linkages))
+(test-assert "More than one linkage" (< 1 (length linkages)))
+
+(define (ids fv) (map inexact->exact (cog-value->list fv)))
+
+; Each linkage has one word id and one disjunct id per word, and the
+; links come in triples, of positions and a label id, all in range.
+(define (layout-ok? lkg)
+	(let* ((wids (ids (cog-value-ref lkg 0)))
+			(links (ids (cog-value-ref lkg 1)))
+			(dids (ids (cog-value-ref lkg 2)))
+			(nwords (length wids)))
+		(and
+			(= nwords (length dids))
+			(= 0 (modulo (length links) 3))
+			(every (lambda (w) (< -1 w (vector-length words))) wids)
+			(every (lambda (d) (< -2 d (vector-length djs))) dids)
+			(let loop ((lks links))
+				(or (null? lks)
+					(and (< -1 (first lks) nwords)
+						(< -1 (second lks) nwords)
+						(< -1 (third lks) (vector-length labels))
+						(loop (drop lks 3))))))))
+
+(test-assert "Layout" (every layout-ok? linkages))
+
+; The disjunct string that LG would print for an LgDisjunct Atom.
+(define (dj-string dj)
+	(string-join
+		(map
+			(lambda (con)
+				(string-append
+					(if (= 3 (cog-arity con)) "@" "")
+					(cog-name (cog-outgoing-atom con 0))
+					(cog-name (cog-outgoing-atom con 1))))
+			(cog-outgoing-set (cog-outgoing-atom dj 1)))
+		" "))
+
+; The (word, disjunct) pairs of the words that have a disjunct, in
+; word order, from the compact encoding and from the Atoms.
+(define (compact-pairs lkg)
+	(filter-map
+		(lambda (wid did)
+			(and (<= 0 did)
+				(cons (vector-ref words wid) (vector-ref djs did))))
+		(ids (cog-value-ref lkg 0))
+		(ids (cog-value-ref lkg 2))))
+
+(define (atom-pairs djlist)
+	(map
+		(lambda (dj) (cons (cog-name (cog-outgoing-atom dj 0)) (dj-string dj)))
+		(cog-value->list djlist)))
+
+(test-assert "Same words and disjuncts as LgParseDisjuncts"
+	(every
+		(lambda (lkg djlist) (equal? (compact-pairs lkg) (atom-pairs djlist)))
+		linkages disjuncts))
+
+; No parse: the three tables, empty, and no linkages.
+(define nothing
+	(cog-value->list
+		(cog-execute!
+			(LgParseCompact (Phrase "\n\n\n\n\n") (LgDictNode "en") (Number 4)))))
+
+(test-equal "No parse: just the tables" 3 (length nothing))
+(test-assert "No parse: empty tables"
+	(every (lambda (tab) (null? (cog-value->list tab))) nothing))
+
+(test-end tname)
+
+(opencog-test-end)
@@ -0,0 +1,49 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; lg-parse-counts-test.scm
+;
+; Unit test for LgParseCounts: counts accumulate on the parse Atoms.
+
+(use-modules (srfi srfi-64))
+(use-modules (opencog))
+(use-modules (opencog exec))
+(use-modules (opencog lg))
+
+(use-modules (opencog test-runner))
+
+(opencog-test-runner)
+
+(define tname "lg-parse-counts-test")
+(test-begin tname)
+
+(define count-key (Predicate "*-lg-parse-count-*"))
+
+(define (count-parse)
+	(cog-execute!
+		(LgParseCounts (Phrase "I saw the dog.") (LgDictNode "en") (Number 1))))
+
+; One linkage; the summary is (linkages bonds disjuncts sections).
+(define summary (cog-value->list (count-parse)))
+(test-equal "One linkage" 1.0 (car summary))
+(test-assert "Some bonds" (< 0 (list-ref summary 1)))
+
+; The bond between "saw" and "dog" must have been counted once.
+(define (dog-bonds)
+	(filter
+		(lambda (edge)
+			(equal? (cog-outgoing-atom edge 1) (List (Word "saw") (Word "dog"))))
+		(cog-get-atoms 'EdgeLink)))
+
+(test-equal "One bond to the dog" 1 (length (dog-bonds)))
+(define dog-bond (car (dog-bonds)))
+(test-equal "Counted once" 1.0 (cog-value-ref (cog-value dog-bond count-key) 0))
+
+; Parse again; the count goes up.
+(count-parse)
+(test-equal "Counted twice" 2.0 (cog-value-ref (cog-value dog-bond count-key) 0))
+
+(test-end tname)
+
+(opencog-test-end)
@@ -0,0 +1,49 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; lg-parse-lazy-test.scm
+;
+; Unit test for lazy parse results: linkages become Atoms only when
+; they are looked at.
+
+(use-modules (srfi srfi-64))
+(use-modules (opencog))
+(use-modules (opencog exec))
+(use-modules (opencog lg))
+
+(use-modules (opencog test-runner))
+
+(opencog-test-runner)
+
+(define tname "lg-parse-lazy-test")
+(test-begin tname)
+
+(define (parse-bonds)
+	(cog-execute!
+		(LgParseBonds (Phrase "I saw the dog.") (LgDictNode "en") (Number 3))))
+
+; First, the eager parse, to compare against.
+(define eager (parse-bonds))
+
+; Then the same, lazily.
+(cog-set-value! (LgDictNode "en") (Predicate "*-lg-lazy-*") (FloatValue 1))
+(define lazy (parse-bonds))
+
+(test-equal "Same number of linkages"
+	(length (cog-value->list eager)) (length (cog-value->list lazy)))
+
+(test-equal "Lazy linkages"
+	'LgLinkageValue (cog-type (cog-value-ref lazy 0)))
+
+; Once looked at, a lazy linkage holds the same as the eager one.
+(test-assert "Same first linkage"
+	(equal?
+		(cog-value->list (cog-value-ref eager 0))
+		(cog-value->list (cog-value-ref lazy 0))))
+
+(cog-set-value! (LgDictNode "en") (Predicate "*-lg-lazy-*") (FloatValue 0))
+
+(test-end tname)
+
+(opencog-test-end)
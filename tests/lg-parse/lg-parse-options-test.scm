@@ -0,0 +1,79 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; lg-parse-options-test.scm
+;
+; Unit test for parse options set on an options AnchorNode: the
+; null count, the parse timeout and the linkage limit.
+
+(use-modules (srfi srfi-64))
+(use-modules (opencog))
+(use-modules (opencog exec))
+(use-modules (opencog lg))
+
+(use-modules (opencog test-runner))
+
+(opencog-test-runner)
+
+(define tname "lg-parse-options-test")
+(test-begin tname)
+
+(define opts (Anchor "parse options"))
+
+; Parse with LgParseLink, using the options on the anchor. A parse
+; that fails throws; that is returned as no linkages at all.
+(define (parse sent)
+	(catch #t
+		(lambda ()
+			(cog-value->list (cog-execute!
+				(LgParseLink (Phrase sent) (LgDictNode "en") (Number 1) opts))))
+		(lambda (key . args) '())))
+
+; Each linkage is (words, bonds, disjuncts, sections). Null-linked
+; words have no disjunct.
+(define (null-count lkg)
+	(- (length (cog-value->list (cog-value-ref lkg 0)))
+		(length (cog-value->list (cog-value-ref lkg 2)))))
+
+(define good "this is a test.")
+(define bad "the the dog dog ran ran.")
+
+; By default, a sentence that does not parse is retried, allowing
+; null-linked words.
+(define bad-default (parse bad))
+(test-equal "Parsed with nulls" 1 (length bad-default))
+(test-assert "Some words are null-linked"
+	(< 0 (null-count (car bad-default))))
+
+; With no nulls allowed, it does not parse at all.
+(cog-set-value! opts (Predicate "*-lg-null-count-*") (FloatValue 0 0))
+(test-equal "No parse without nulls" 0 (length (parse bad)))
+
+(define good-no-nulls (parse good))
+(test-equal "Good sentence still parses" 1 (length good-no-nulls))
+(test-equal "Good sentence has no nulls" 0 (null-count (car good-no-nulls)))
+
+(cog-set-value! opts (Predicate "*-lg-null-count-*") (FloatValue))
+
+; Timeouts too big for LG are taken as the biggest it can do.
+(cog-set-value! opts (Predicate "*-lg-max-parse-time-*") (FloatValue 1e30))
+(test-equal "Huge timeout" 1 (length (parse good)))
+
+(cog-set-value! opts (Predicate "*-lg-max-parse-time-*") (FloatValue))
+
+; The linkage limit reaches the parser: asking for all linkages of an
+; ambiguous sentence gives no more than the limit.
+(define (parse-all sent)
+	(cog-value->list (cog-execute!
+		(LgParseLink (Phrase sent) (LgDictNode "en") (Number 0) opts))))
+(define ambiguous "I saw the man with the telescope on the hill with the dog.")
+(define nall (length (parse-all ambiguous)))
+(test-assert "Ambiguous sentence has many linkages" (< 3 nall))
+(cog-set-value! opts (Predicate "*-lg-linkage-limit-*") (FloatValue 2))
+(test-equal "Linkage limit respected" 2 (length (parse-all ambiguous)))
+(cog-set-value! opts (Predicate "*-lg-linkage-limit-*") (FloatValue))
+
+(test-end tname)
+
+(opencog-test-end)
@@ -0,0 +1,106 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; lg-parse-stream-test.scm
+;
+; Unit test for LgParseStream: results in order, end-of-file, a bad
+; Value from upstream, and backpressure.
+
+(use-modules (srfi srfi-1))
+(use-modules (srfi srfi-64))
+(use-modules (opencog))
+(use-modules (opencog exec))
+(use-modules (opencog lg))
+
+(use-modules (opencog test-runner))
+
+(opencog-test-runner)
+
+(define tname "lg-parse-stream-test")
+(test-begin tname)
+
+; The upstream hands out one sentence per call, and then whatever
+; `the-end` is, for ever after. It counts the calls.
+(define sentences '())
+(define the-end (StringValue))
+(define npulls 0)
+(define (next-sentence)
+	(set! npulls (+ npulls 1))
+	(if (null? sentences)
+		the-end
+		(let ((sent (car sentences)))
+			(set! sentences (cdr sentences))
+			(Phrase sent))))
+
+(define (stream-of sents end window)
+	(set! sentences sents)
+	(set! the-end end)
+	(cog-execute!
+		(LgParseStream
+			(LgParseBonds
+				(ExecutionOutput (GroundedSchema "scm: next-sentence") (List))
+				(LgDictNode "en")
+				(NumberNode 1))
+			(NumberNode window))))
+
+; The words of the first linkage of a result.
+(define (first-words result)
+	(cog-value->list (cog-value-ref (cog-value-ref result 0) 0)))
+
+(cog-set-value! (LgDictNode "en")
+	(Predicate "*-lg-parse-threads-*") (FloatValue 3))
+
+; More sentences than threads, and a window smaller than the input.
+(define input
+	'("this is a test." "I saw the dog." "she runs." "the cat sat."
+	  "he ate a pie." "we left early." "they sing."))
+(define markers
+	(list (Word "test") (Word "dog") (Word "runs") (Word "cat")
+	      (Word "pie") (Word "early") (Word "sing")))
+
+; Reading the queue waits until it is closed; it is closed at the
+; end-of-file marker.
+(define results (cog-value->list (stream-of input the-end 2)))
+
+(test-equal "One result per sentence" (length input) (length results))
+(test-assert "Results in input order"
+	(every (lambda (res word) (member word (first-words res)))
+		results markers))
+
+; A bad Value ends the stream; what came before it is still parsed.
+(define bad-results
+	(cog-value->list
+		(stream-of '("this is a test." "she runs.") (FloatValue 1 2 3) 4)))
+
+(test-equal "Stream stops at a bad Value" 2 (length bad-results))
+(test-assert "Parsed up to the bad Value"
+	(member (Word "runs") (first-words (cadr bad-results))))
+
+; Same, for a StringValue holding more than one string, in a LinkValue.
+(define multi-results
+	(cog-value->list
+		(stream-of '("I saw the dog.")
+			(LinkValue (StringValue "a" "b")) 4)))
+
+(test-equal "Stream stops at a bad LinkValue" 1 (length multi-results))
+
+; Backpressure. With nothing drained, no more than the window, plus
+; one more chunk (here, one sentence) waiting for room, is pulled.
+(cog-set-value! (LgDictNode "en")
+	(Predicate "*-lg-parse-threads-*") (FloatValue 1))
+(set! npulls 0)
+(define many (make-list 20 "the cat sat."))
+(define slow-queue (stream-of many the-end 3))
+(sleep 3)
+(test-assert "Pulls bounded by the window" (<= npulls 4))
+(test-assert "Some were pulled" (< 0 npulls))
+
+; Draining it lets the rest through.
+(test-equal "All parsed once drained" 20
+	(length (cog-value->list slow-queue)))
+(test-equal "All pulled, and the end" 21 npulls)
+
+(test-end tname)
+
+(opencog-test-end)